@@ -0,0 +1,629 @@
+// cloakwork_bench - per-primitive cost numbers for regression tracking
+//
+// every primitive is measured through its own noinline kernel: one macro use plus
+// one read per op, on a loop index so nothing can be hoisted. each kernel is run
+// REPETITIONS times and the median is reported, which keeps the numbers stable
+// across runs. on elf targets every kernel lives in its own section, so its inlined
+// code size can be read from the linker-provided section bounds.
+//
+// the scaling rows run a kernel on 1, 2, 4, ... 64 threads at once and report the total
+// ops per second: the generated_variants dispatcher, and lock-free reads of one shared
+// scattered_value and polymorphic_value.
+//
+// the const_loop rows run CONST_LOOP_STEPS steps of a multiply-xor recurrence on two
+// constants, once with plain literals and once through CW_CONST / CW_CONST_MBA: with the
+// decode hoisted out of the loop all three should cost about the same per op.
+//
+// the cw_scatter_live rows repeat the CW_SCATTER kernel with 100k and 1M other scattered
+// values alive, and the memory rows give the resident bytes per live value (linux), next
+// to the layout scattered_value had before its arena: one heap allocation per chunk.
+//
+// usage: cloakwork_bench [output.json]      (json goes to stdout without a path)
+
+#include "cloakwork.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>
+#endif
+
+#if defined(__linux__)
+    #include <unistd.h>
+#endif
+
+// place a kernel in its own section so its size can be measured (elf only)
+#if defined(__ELF__)
+    #define BENCH_KERNEL(name) \
+        extern "C" const char __start_cwb_##name[] __attribute__((weak)); \
+        extern "C" const char __stop_cwb_##name[] __attribute__((weak)); \
+        static size_t name##_code_size() { \
+            return __start_cwb_##name && __stop_cwb_##name ? static_cast<size_t>(__stop_cwb_##name - __start_cwb_##name) : 0; \
+        } \
+        __attribute__((section("cwb_" #name), noinline)) static uint64_t name##_kernel(uint64_t i)
+#else
+    #define BENCH_KERNEL(name) \
+        static size_t name##_code_size() { return 0; } \
+        CW_NOINLINE static uint64_t name##_kernel(uint64_t i)
+#endif
+
+namespace {
+    constexpr size_t REPETITIONS = 9;
+    constexpr size_t HASH_BYTES = 4096;
+    constexpr size_t ASSET_BYTES = 64 * 1024;
+    constexpr size_t ARX_RANGE_BYTES = 4096;
+    constexpr size_t ARCHIVE_ENTRIES = 1024;
+    constexpr size_t WIPE_BYTES = 1024;
+    constexpr size_t VARIANTS = 4;          // one generated variant per transformation kind
+    constexpr size_t HANDLERS = 8;
+    constexpr size_t PROGRAM_OPS = 64;
+    constexpr size_t CONST_LOOP_STEPS = 256;
+    constexpr size_t MAX_THREADS = 64;
+    constexpr size_t SCALING_OPS = size_t(1) << 20;     // split across the threads
+    constexpr size_t SCALING_ROUNDS = 5;
+    constexpr size_t LIVE_VALUES[] = { 100000, 1000000 };
+
+    uint64_t cycles() {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        return __rdtsc();
+#elif defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return 0;
+#endif
+    }
+
+    CW_NOINLINE int bench_target(int x) {
+        return x * 3 + 1;
+    }
+
+    using bench_variants = cloakwork::metamorphic::generated_variants<&bench_target, VARIANTS>;
+
+    const auto& bench_dispatcher() {
+        static const auto dispatcher = bench_variants::dispatcher();
+        return dispatcher;
+    }
+
+    // opcode handlers of a toy interpreter
+    using handler_fn = uint64_t(uint64_t);
+
+    template<uint64_t K>
+    CW_NOINLINE uint64_t handler(uint64_t x) {
+        return x * (2 * K + 1) + K;
+    }
+
+    template<size_t... K>
+    constexpr std::array<handler_fn*, sizeof...(K)> make_handlers(std::index_sequence<K...>) {
+        return { &handler<K>... };
+    }
+
+    constexpr auto plain_handlers = make_handlers(std::make_index_sequence<HANDLERS>{});
+
+    const auto& table_handlers() {
+        static const auto table = [] {
+            cloakwork::obfuscated_dispatch_table<handler_fn, HANDLERS> t;
+            for (size_t k = 0; k < HANDLERS; ++k) t.set(k, plain_handlers[k]);
+            return t;
+        }();
+        return table;
+    }
+
+    constexpr std::array<uint8_t, PROGRAM_OPS> program = [] {
+        std::array<uint8_t, PROGRAM_OPS> p{};
+        for (size_t i = 0; i < PROGRAM_OPS; ++i) p[i] = static_cast<uint8_t>((i * 5 + 3) % HANDLERS);
+        return p;
+    }();
+
+    cloakwork::data_hiding::scattered_value<uint64_t>& shared_scatter() {
+        static cloakwork::data_hiding::scattered_value<uint64_t> value(0x5EED);
+        return value;
+    }
+
+    cloakwork::data_hiding::polymorphic_value<uint64_t>& shared_poly() {
+        static cloakwork::data_hiding::polymorphic_value<uint64_t> value(0x5EED);
+        return value;
+    }
+
+    const char* hash_input() {
+        static const char text[] = "kernel32.dll!VirtualAllocEx+0x40";
+        return text;
+    }
+
+    const uint8_t* hash_buffer() {
+        static std::vector<uint8_t> buffer = [] {
+            std::vector<uint8_t> b(HASH_BYTES);
+            for (size_t i = 0; i < b.size(); ++i) b[i] = static_cast<uint8_t>(i * 131 + 7);
+            return b;
+        }();
+        return buffer.data();
+    }
+
+    // one default-sized chunk, so a read is one chunk of a streamed asset
+    const cloakwork::asset::encrypted_asset& bench_asset() {
+        static const std::vector<uint8_t> packed = [] {
+            std::vector<uint8_t> plain(ASSET_BYTES);
+            for (size_t i = 0; i < plain.size(); ++i) plain[i] = static_cast<uint8_t>(i * 131 + 7);
+            return cloakwork::asset::pack(plain.data(), plain.size(), CW_ASSET_KEY("cloakwork bench"));
+        }();
+        static const cloakwork::asset::encrypted_asset asset(packed.data(), packed.size(), CW_ASSET_KEY("cloakwork bench"));
+        return asset;
+    }
+
+    uint8_t* asset_buffer() {
+        static std::vector<uint8_t> buffer(ASSET_BYTES);
+        return buffer.data();
+    }
+
+    uint8_t* wipe_buffer() {
+        static std::vector<uint8_t> buffer(WIPE_BYTES);
+        return buffer.data();
+    }
+
+    // a WIPE_BYTES literal for the stack string kernel
+    struct wipe_literal {
+        char text[WIPE_BYTES];
+    };
+
+    constexpr wipe_literal wipe_text = [] {
+        wipe_literal l{};
+        for (size_t i = 0; i + 1 < WIPE_BYTES; ++i) l.text[i] = static_cast<char>('a' + (i * 7) % 26);
+        return l;
+    }();
+
+    const auto& stack_source() {
+        static cloakwork::string_encrypt::encrypted_string<WIPE_BYTES> enc(wipe_text.text);
+        return enc;
+    }
+
+    // ARCHIVE_ENTRIES small entries named "entry/<i>"
+    struct bench_archive_data {
+        std::vector<uint8_t> plain;
+        std::vector<uint32_t> hashes;
+        std::vector<uint8_t> packed;
+        cloakwork::asset::encrypted_archive archive;
+    };
+
+    const bench_archive_data& bench_archive() {
+        static const bench_archive_data data = [] {
+            bench_archive_data d;
+            d.plain.resize(ARCHIVE_ENTRIES * 64);
+            for (size_t i = 0; i < d.plain.size(); ++i) d.plain[i] = static_cast<uint8_t>(i * 131 + 7);
+            cloakwork::asset::archive_builder builder;
+            for (size_t i = 0; i < ARCHIVE_ENTRIES; ++i) {
+                const std::string name = "entry/" + std::to_string(i);
+                d.hashes.push_back(cloakwork::hash::fnv1a_runtime(name.c_str()));
+                builder.add(d.hashes.back(), d.plain.data() + i * 64, 64);
+            }
+            d.packed = builder.build(CW_ASSET_KEY("cloakwork bench"));
+            d.archive = cloakwork::asset::encrypted_archive(d.packed.data(), d.packed.size(), CW_ASSET_KEY("cloakwork bench"));
+            return d;
+        }();
+        return data;
+    }
+}
+
+BENCH_KERNEL(plain) {
+    return i * 3 + 1;
+}
+
+BENCH_KERNEL(cw_str) {
+    return static_cast<uint8_t>(CW_STR("benchmark string value")[i & 15]);
+}
+
+BENCH_KERNEL(cw_str_layered) {
+    return static_cast<uint8_t>(CW_STR_LAYERED("benchmark string value")[i & 15]);
+}
+
+BENCH_KERNEL(cw_str_arx) {
+    return static_cast<uint8_t>(CW_STR_ARX("benchmark string value")[i & 15]);
+}
+
+BENCH_KERNEL(cw_wstr) {
+    return static_cast<uint64_t>(CW_WSTR(L"benchmark string value")[i & 15]);
+}
+
+BENCH_KERNEL(cw_int) {
+    int value = CW_INT(static_cast<int>(i));
+    return static_cast<uint64_t>(value);
+}
+
+BENCH_KERNEL(cw_mba) {
+    int value = CW_MBA(static_cast<int>(i));
+    return static_cast<uint64_t>(value);
+}
+
+BENCH_KERNEL(cw_scatter) {
+    auto scattered = CW_SCATTER(i);
+    return static_cast<uint64_t>(scattered);
+}
+
+BENCH_KERNEL(cw_poly) {
+    auto poly = CW_POLY(i);
+    return static_cast<uint64_t>(poly);
+}
+
+BENCH_KERNEL(cw_call) {
+    return static_cast<uint64_t>(CW_CALL(bench_target)(static_cast<int>(i)));
+}
+
+BENCH_KERNEL(cw_flatten) {
+    return static_cast<uint64_t>(CW_FLATTEN(bench_target, static_cast<int>(i)));
+}
+
+BENCH_KERNEL(cw_const) {
+    return i + static_cast<uint64_t>(CW_CONST(0x5EED1234));
+}
+
+// the same inner loop with literal, CW_CONST and CW_CONST_MBA constants
+BENCH_KERNEL(const_loop_plain) {
+    uint64_t x = i;
+    for (size_t k = 0; k < CONST_LOOP_STEPS; ++k) x = (x ^ 0x9E3779B97F4A7C15ull) * 0x100000001B3ull + k;
+    return x;
+}
+
+BENCH_KERNEL(const_loop_cw) {
+    uint64_t x = i;
+    for (size_t k = 0; k < CONST_LOOP_STEPS; ++k) x = (x ^ CW_CONST(0x9E3779B97F4A7C15ull)) * CW_CONST(0x100000001B3ull) + k;
+    return x;
+}
+
+BENCH_KERNEL(const_loop_mba) {
+    uint64_t x = i;
+    for (size_t k = 0; k < CONST_LOOP_STEPS; ++k) x = (x ^ CW_CONST_MBA(0x9E3779B97F4A7C15ull)) * CW_CONST_MBA(0x100000001B3ull) + k;
+    return x;
+}
+
+BENCH_KERNEL(fnv1a_runtime) {
+    return i ^ cloakwork::hash::fnv1a_runtime(hash_input());
+}
+
+BENCH_KERNEL(crc32) {
+    return i ^ cloakwork::crc::crc32(hash_buffer(), HASH_BYTES);
+}
+
+BENCH_KERNEL(crc32c) {
+    return i ^ cloakwork::crc::crc32c(hash_buffer(), HASH_BYTES);
+}
+
+BENCH_KERNEL(asset_chunk) {
+    uint8_t* out = asset_buffer();
+    bench_asset().read(0, out, ASSET_BYTES);
+    return i ^ out[i & (ASSET_BYTES - 1)];
+}
+
+// a 4 KiB range at an unaligned offset inside a 64 KiB stream
+BENCH_KERNEL(arx_range) {
+    static constexpr cloakwork::stream::arx cipher(0x0123456789abcdefull, 0xfedcba9876543210ull, 1, 2, 3);
+    uint8_t* out = asset_buffer();
+    const uint64_t offset = (i * 8191) & (ASSET_BYTES - ARX_RANGE_BYTES - 1);
+    cipher.apply(out, out, ARX_RANGE_BYTES, offset);
+    return i ^ out[i & (ARX_RANGE_BYTES - 1)];
+}
+
+// wipe cost per KiB: zeroing, noise fill, and a stack string's copy-in plus scramble
+BENCH_KERNEL(secure_wipe) {
+    uint8_t* buf = wipe_buffer();
+    cloakwork::secure_wipe(buf, WIPE_BYTES);
+    return i ^ buf[i & (WIPE_BYTES - 1)];
+}
+
+BENCH_KERNEL(secure_scramble) {
+    uint8_t* buf = wipe_buffer();
+    cloakwork::secure_scramble(buf, WIPE_BYTES);
+    return i ^ buf[i & (WIPE_BYTES - 1)];
+}
+
+BENCH_KERNEL(stack_string) {
+    cloakwork::string_encrypt::stack_encrypted_string<WIPE_BYTES> text(stack_source());
+    return static_cast<uint8_t>(text.get()[i & (WIPE_BYTES - 2)]);
+}
+
+BENCH_KERNEL(archive_lookup) {
+    const auto& d = bench_archive();
+    uint8_t out[16];
+    d.archive.find(d.hashes[i & (ARCHIVE_ENTRIES - 1)]).read(i & 31, out, sizeof(out));
+    return i ^ out[0];
+}
+
+// reads and writes of a long-lived value (CW_SCATTER / CW_POLY above also construct one)
+BENCH_KERNEL(scatter_get) {
+    return i ^ shared_scatter().get();
+}
+
+BENCH_KERNEL(scatter_set) {
+    shared_scatter().set(i);
+    return i;
+}
+
+BENCH_KERNEL(poly_get) {
+    return i ^ shared_poly().get();
+}
+
+// one metamorphic call, through the per-thread variant rotation
+BENCH_KERNEL(metamorphic_call) {
+    return static_cast<uint64_t>(bench_dispatcher()(static_cast<int>(i)));
+}
+
+// a PROGRAM_OPS-op interpreter loop through a plain array of function pointers and through
+// an obfuscated_dispatch_table. the plain array is hidden from the optimizer so its calls
+// stay indirect
+BENCH_KERNEL(dispatch_plain) {
+    const std::array<handler_fn*, HANDLERS>* handlers = &plain_handlers;
+    CW_REGISTER_BARRIER(handlers);
+    uint64_t x = i;
+    for (uint8_t op : program) x = (*handlers)[op](x);
+    return x;
+}
+
+BENCH_KERNEL(dispatch_table) {
+    const auto& handlers = table_handlers();
+    uint64_t x = i;
+    for (uint8_t op : program) x = handlers(op, x);
+    return x;
+}
+
+// a direct call of each generated variant, in static cost order (kinds 0 to 3)
+template<size_t Kind>
+CW_NOINLINE static uint64_t variant_kernel(uint64_t i) {
+    constexpr auto func = bench_variants::by_static_cost()[Kind];
+    return static_cast<uint64_t>(func(static_cast<int>(i)));
+}
+
+namespace {
+    struct result {
+        const char* name;
+        double ns_per_op;
+        double cycles_per_op;
+        size_t code_bytes;
+        size_t bytes_per_op;
+    };
+
+    using kernel_fn = uint64_t(*)(uint64_t);
+
+    volatile uint64_t sink;
+
+    // picks an iteration count that runs for roughly 20ms, then takes the median of REPETITIONS
+    result measure(const char* name, kernel_fn kernel, size_t code_bytes, size_t bytes_per_op = 0) {
+        using clock = std::chrono::steady_clock;
+
+        uint64_t acc = 0;
+        size_t iterations = 64;
+        for (;;) {
+            auto start = clock::now();
+            for (size_t i = 0; i < iterations; ++i) acc += kernel(i);
+            if (clock::now() - start > std::chrono::milliseconds(20) || iterations >= (size_t(1) << 26)) break;
+            iterations *= 2;
+        }
+
+        std::vector<double> ns(REPETITIONS), cyc(REPETITIONS);
+        for (size_t r = 0; r < REPETITIONS; ++r) {
+            uint64_t c0 = cycles();
+            auto start = clock::now();
+            for (size_t i = 0; i < iterations; ++i) acc += kernel(i);
+            auto elapsed = clock::now() - start;
+            uint64_t c1 = cycles();
+
+            ns[r] = std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(iterations);
+            cyc[r] = static_cast<double>(c1 - c0) / static_cast<double>(iterations);
+        }
+        sink = acc;
+
+        std::sort(ns.begin(), ns.end());
+        std::sort(cyc.begin(), cyc.end());
+        return { name, ns[REPETITIONS / 2], cyc[REPETITIONS / 2], code_bytes, bytes_per_op };
+    }
+
+    // CW_SCATTER with `live` other values holding arena slots
+    result measure_with_live(const char* name, size_t live) {
+        std::vector<cloakwork::data_hiding::scattered_value<uint64_t>> values;
+        values.reserve(live);
+        for (size_t i = 0; i < live; ++i) values.emplace_back(static_cast<uint64_t>(i));
+        return measure(name, &cw_scatter_kernel, cw_scatter_code_size());
+    }
+
+    struct memory_result {
+        const char* name;
+        size_t live;
+        double rss_bytes_per_value;
+    };
+
+    // resident set size (linux only; 0 elsewhere)
+    size_t resident_bytes() {
+#if defined(__linux__)
+        std::FILE* f = std::fopen("/proc/self/statm", "r");
+        if (!f) return 0;
+        unsigned long pages = 0, resident = 0;
+        const int fields = std::fscanf(f, "%lu %lu", &pages, &resident);
+        std::fclose(f);
+        return fields == 2 ? static_cast<size_t>(resident) * static_cast<size_t>(sysconf(_SC_PAGESIZE)) : 0;
+#else
+        return 0;
+#endif
+    }
+
+    // one heap allocation per chunk, as scattered_value<uint64_t> did before scatter_arena
+    struct heap_chunks {
+        std::array<std::unique_ptr<uint8_t[]>, 8> chunks;
+
+        explicit heap_chunks(uint64_t value) {
+            for (size_t i = 0; i < chunks.size(); ++i) {
+                chunks[i] = std::make_unique<uint8_t[]>(1);
+                chunks[i][0] = static_cast<uint8_t>(value >> (i * 8));
+            }
+        }
+    };
+
+    // resident growth while `live` values (and the vector holding them) exist
+    template<typename V>
+    memory_result measure_rss(const char* name, size_t live) {
+        const size_t before = resident_bytes();
+        std::vector<V> values;
+        values.reserve(live);
+        for (size_t i = 0; i < live; ++i) values.emplace_back(static_cast<uint64_t>(i));
+        const size_t after = resident_bytes();
+        return { name, live, after > before ? static_cast<double>(after - before) / static_cast<double>(live) : 0.0 };
+    }
+
+    struct scaling_result {
+        const char* name;
+        size_t threads;
+        double ops_per_sec;
+    };
+
+    // SCALING_OPS calls of kernel split over `threads` threads, released together;
+    // the median of SCALING_ROUNDS total throughputs
+    scaling_result measure_threads(const char* name, kernel_fn kernel, size_t threads) {
+        const size_t per_thread = SCALING_OPS / threads;
+        std::vector<double> rates(SCALING_ROUNDS);
+        for (auto& rate : rates) {
+            std::atomic<size_t> ready{0};
+            std::atomic<bool> go{false};
+            std::atomic<uint64_t> total{0};
+            std::vector<std::thread> pool;
+            for (size_t t = 0; t < threads; ++t) {
+                pool.emplace_back([&, t] {
+                    uint64_t acc = 0;
+                    ready.fetch_add(1);
+                    while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+                    for (size_t i = 0; i < per_thread; ++i) acc += kernel(i + t);
+                    total.fetch_add(acc, std::memory_order_relaxed);
+                });
+            }
+            while (ready.load() < threads) std::this_thread::yield();
+
+            auto start = std::chrono::steady_clock::now();
+            go.store(true, std::memory_order_release);
+            for (auto& th : pool) th.join();
+            const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            sink = total.load();
+            rate = static_cast<double>(threads * per_thread) / seconds;
+        }
+        std::sort(rates.begin(), rates.end());
+        return { name, threads, rates[SCALING_ROUNDS / 2] };
+    }
+
+    const char* compiler() {
+#if defined(__clang__)
+        return "clang " __clang_version__;
+#elif defined(__GNUC__)
+        return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+        return "msvc";
+#else
+        return "unknown";
+#endif
+    }
+
+    void write_json(std::FILE* out, const std::vector<result>& results, const std::vector<scaling_result>& scaling,
+                    const std::vector<memory_result>& memory) {
+        std::fprintf(out, "{\n");
+        std::fprintf(out, "  \"compiler\": \"%s\",\n", compiler());
+        std::fprintf(out, "  \"cycles_source\": \"%s\",\n", cycles() ? "tsc" : "none");
+        std::fprintf(out, "  \"repetitions\": %zu,\n", REPETITIONS);
+        std::fprintf(out, "  \"primitives\": [\n");
+        for (size_t i = 0; i < results.size(); ++i) {
+            const result& r = results[i];
+            std::fprintf(out, "    {\"name\": \"%s\", \"ns_per_op\": %.3f, \"cycles_per_op\": %.1f, \"code_bytes\": %zu",
+                         r.name, r.ns_per_op, r.cycles_per_op, r.code_bytes);
+            if (r.bytes_per_op) {
+                std::fprintf(out, ", \"bytes_per_op\": %zu, \"gb_per_s\": %.2f", r.bytes_per_op,
+                             static_cast<double>(r.bytes_per_op) / r.ns_per_op);
+            }
+            std::fprintf(out, "}%s\n", i + 1 < results.size() ? "," : "");
+        }
+        std::fprintf(out, "  ],\n");
+        std::fprintf(out, "  \"scaling\": [\n");
+        for (size_t i = 0; i < scaling.size(); ++i) {
+            std::fprintf(out, "    {\"name\": \"%s\", \"threads\": %zu, \"ops_per_sec\": %.0f}%s\n", scaling[i].name,
+                         scaling[i].threads, scaling[i].ops_per_sec, i + 1 < scaling.size() ? "," : "");
+        }
+        std::fprintf(out, "  ],\n");
+        std::fprintf(out, "  \"memory\": [\n");
+        for (size_t i = 0; i < memory.size(); ++i) {
+            std::fprintf(out, "    {\"name\": \"%s\", \"live_values\": %zu, \"rss_bytes_per_value\": %.1f}%s\n", memory[i].name,
+                         memory[i].live, memory[i].rss_bytes_per_value, i + 1 < memory.size() ? "," : "");
+        }
+        std::fprintf(out, "  ]\n}\n");
+    }
+}
+
+int main(int argc, char** argv) {
+    // first, so the arena and the heap start without freed memory to reuse
+    std::vector<memory_result> memory;
+    memory.push_back(measure_rss<cloakwork::data_hiding::scattered_value<uint64_t>>("scattered_value", LIVE_VALUES[1]));
+    memory.push_back(measure_rss<heap_chunks>("heap_chunks", LIVE_VALUES[1]));
+
+    std::vector<result> results;
+
+    #define RUN(name, ...) results.push_back(measure(#name, &name##_kernel, name##_code_size(), ##__VA_ARGS__))
+    RUN(plain);
+    RUN(cw_str);
+    RUN(cw_str_layered);
+    RUN(cw_str_arx);
+    RUN(cw_wstr);
+    RUN(cw_int);
+    RUN(cw_mba);
+    RUN(cw_scatter);
+    RUN(cw_poly);
+    RUN(cw_call);
+    RUN(cw_flatten);
+    RUN(cw_const);
+    RUN(const_loop_plain);
+    RUN(const_loop_cw);
+    RUN(const_loop_mba);
+    RUN(fnv1a_runtime);
+    RUN(crc32, HASH_BYTES);
+    RUN(crc32c, HASH_BYTES);
+    RUN(asset_chunk, ASSET_BYTES);
+    RUN(arx_range, ARX_RANGE_BYTES);
+    RUN(archive_lookup);
+    RUN(secure_wipe, WIPE_BYTES);
+    RUN(secure_scramble, WIPE_BYTES);
+    RUN(stack_string, WIPE_BYTES);
+    RUN(scatter_get);
+    RUN(scatter_set);
+    RUN(poly_get);
+    RUN(metamorphic_call);
+    RUN(dispatch_plain);
+    RUN(dispatch_table);
+    #undef RUN
+
+    results.push_back(measure_with_live("cw_scatter_live_100k", LIVE_VALUES[0]));
+    results.push_back(measure_with_live("cw_scatter_live_1m", LIVE_VALUES[1]));
+
+    results.push_back(measure("variant_kind0", &variant_kernel<0>, 0));
+    results.push_back(measure("variant_kind1", &variant_kernel<1>, 0));
+    results.push_back(measure("variant_kind2", &variant_kernel<2>, 0));
+    results.push_back(measure("variant_kind3", &variant_kernel<3>, 0));
+
+    std::vector<scaling_result> scaling;
+    for (size_t threads = 1; threads <= MAX_THREADS; threads *= 2) {
+        scaling.push_back(measure_threads("metamorphic_call", &metamorphic_call_kernel, threads));
+        scaling.push_back(measure_threads("scatter_get", &scatter_get_kernel, threads));
+        scaling.push_back(measure_threads("poly_get", &poly_get_kernel, threads));
+    }
+
+    std::FILE* out = stdout;
+    if (argc > 1) {
+        out = std::fopen(argv[1], "w");
+        if (!out) {
+            std::fprintf(stderr, "cloakwork_bench: cannot open %s\n", argv[1]);
+            return 1;
+        }
+    }
+
+    write_json(out, results, scaling, memory);
+    if (out != stdout) std::fclose(out);
+    return 0;
+}
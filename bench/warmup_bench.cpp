@@ -0,0 +1,119 @@
+// cloakwork_warmup_bench - cloakwork::warmup() / cooldown() time versus thread count, and
+// the cost of a cloakwork::reencrypt_all() pass
+//
+// SITES encrypted literals enroll themselves at static init (CW_ENABLE_WARMUP). every
+// round re-encrypts them all, then times a warmup on 1, 2, 4, ... threads; the median of
+// ROUNDS is reported per thread count. the cold / warm rows time one call of every site
+// without and after a warmup, which is the first-use latency the warmup takes off the
+// request path. the reseal rows time reencrypt_all() over LIVE_OBJECTS decrypted literals
+// (the sites plus heap-allocated ones), and again once they are all sealed.
+//
+// usage: cloakwork_warmup_bench [output.json]      (json goes to stdout without a path)
+
+#define CW_ENABLE_WARMUP 1
+#include "cloakwork.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+    constexpr size_t SITES = 1024;
+    constexpr size_t ROUNDS = 9;
+    constexpr size_t LIVE_OBJECTS = 10000;
+
+    volatile uint64_t sink;
+
+    // one site per instantiation: every I gets its own lambda, static and warmup task
+    template<size_t I>
+    const char* site() {
+        return CW_STR("warmup benchmark literal, long enough to cost more than the lock: "
+                      "0123456789abcdefghijklmnopqrstuvwxyz");
+    }
+
+    template<size_t... I>
+    constexpr std::array<const char* (*)(), sizeof...(I)> make_sites(std::index_sequence<I...>) {
+        return { &site<I>... };
+    }
+
+    const auto sites = make_sites(std::make_index_sequence<SITES>{});
+
+    // every round starts from all-encrypted, runs setup untimed, then times body
+    template<typename S, typename F>
+    double median_us(S&& setup, F&& body) {
+        std::vector<double> us(ROUNDS);
+        for (auto& u : us) {
+            cloakwork::cooldown();
+            setup();
+            auto start = std::chrono::steady_clock::now();
+            body();
+            u = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        }
+        std::sort(us.begin(), us.end());
+        return us[ROUNDS / 2];
+    }
+
+    // one call of every site
+    void touch_all() {
+        uint64_t acc = 0;
+        for (auto fn : sites) acc += static_cast<uint8_t>(fn()[0]);
+        sink = acc;
+    }
+}
+
+int main(int argc, char** argv) {
+    const size_t enrolled = cloakwork::registry::warm_count();
+    const unsigned hardware = std::max(std::thread::hardware_concurrency(), 1u);
+
+    std::vector<std::pair<unsigned, double>> rows;
+    for (unsigned threads = 1; threads <= std::max(hardware, 8u); threads *= 2) {
+        rows.emplace_back(threads, median_us([] {}, [threads] { cloakwork::warmup(threads); }));
+    }
+    const double cold = median_us([] {}, touch_all);
+    const double warm = median_us([] { cloakwork::warmup(); }, touch_all);
+
+    // the rest of the 10k live objects, all listed by their first get()
+    static constexpr char text[] = "reseal benchmark literal, the same length as a short message";
+    std::deque<cloakwork::string_encrypt::encrypted_string<sizeof(text)>> extra;
+    for (size_t i = SITES; i < LIVE_OBJECTS; ++i) extra.emplace_back(text);
+    auto decrypt_all = [&extra] {
+        cloakwork::warmup();
+        for (const auto& s : extra) (void)s.get();
+    };
+    const double reseal = median_us(decrypt_all, [] { cloakwork::reencrypt_all(); });
+    const double reseal_sealed = median_us([] {}, [] { cloakwork::reencrypt_all(); });
+    const size_t live = cloakwork::registry::live_count();
+
+    std::FILE* out = stdout;
+    if (argc > 1) {
+        out = std::fopen(argv[1], "w");
+        if (!out) {
+            std::fprintf(stderr, "cloakwork_warmup_bench: cannot open %s\n", argv[1]);
+            return 1;
+        }
+    }
+
+    std::fprintf(out, "{\n");
+    std::fprintf(out, "  \"sites\": %zu,\n", enrolled);
+    std::fprintf(out, "  \"hardware_threads\": %u,\n", hardware);
+    std::fprintf(out, "  \"rounds\": %zu,\n", ROUNDS);
+    std::fprintf(out, "  \"warmup\": [\n");
+    for (size_t i = 0; i < rows.size(); ++i) {
+        std::fprintf(out, "    {\"threads\": %u, \"us\": %.1f, \"ns_per_site\": %.1f}%s\n", rows[i].first, rows[i].second,
+                     rows[i].second * 1000.0 / static_cast<double>(enrolled), i + 1 < rows.size() ? "," : "");
+    }
+    std::fprintf(out, "  ],\n");
+    std::fprintf(out, "  \"first_use_cold_us\": %.1f,\n", cold);
+    std::fprintf(out, "  \"first_use_after_warmup_us\": %.1f,\n", warm);
+    std::fprintf(out, "  \"live_objects\": %zu,\n", live);
+    std::fprintf(out, "  \"reencrypt_all_us\": %.1f,\n", reseal);
+    std::fprintf(out, "  \"reencrypt_all_sealed_us\": %.1f\n", reseal_sealed);
+    std::fprintf(out, "}\n");
+    if (out != stdout) std::fclose(out);
+    return 0;
+}
@@ -0,0 +1,74 @@
+// cloakwork.cppm - cloakwork as a c++20 named module
+//
+//   import cloakwork;
+//   cloakwork::obfuscated_value<int> v(42);
+//   uint32_t c = cloakwork::crc::crc32c(buf, len);
+//
+// the module exports every type and function of cloakwork.h. the CW_* macros are
+// preprocessor-only and cannot cross a module boundary, so translation units that use
+// them still include cloakwork.h (or one of the modular headers) or import it as a header
+// unit (`import "cloakwork.h";`). the declarations are attached to the global module,
+// which lets the import and the header be mixed freely in one program.
+//
+// configuration macros (CW_ENABLE_* etc.) must be set on the command line when the
+// module is built, and must match any translation unit that also includes the header.
+
+module;
+
+// every system header the library uses goes in the global module fragment, so the
+// includes inside cloakwork.h below are no-ops and only cloakwork's own declarations
+// end up in the module purview
+#include "cloakwork/platform.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <source_location>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+    #include <nmmintrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>
+    #include <cpuid.h>
+#elif defined(__aarch64__) && defined(__linux__)
+    #include <arm_acle.h>
+    #include <sys/auxv.h>
+#endif
+
+#if defined(__linux__)
+    #include <link.h>
+#endif
+
+#if !defined(_WIN32)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+export module cloakwork;
+
+export extern "C++" {
+#include "cloakwork.h"
+}
@@ -0,0 +1,718 @@
+#ifndef CLOAKWORK_ANTI_DEBUG_H
+#define CLOAKWORK_ANTI_DEBUG_H
+
+// cloakwork/anti_debug.h - debugger, analysis-tool and vm/sandbox detection (CW_ANTI_DEBUG,
+// CW_INLINE_CHECK, CW_ANTI_VM). value, control-flow and call protection use its inline checks
+
+#include "hash.h"
+#include "platform.h"
+
+CW_PUSH_WARNINGS
+
+namespace cloakwork {
+
+    // =================================================================
+    // anti-debugging and anti-analysis
+    // =================================================================
+
+#if CW_ENABLE_ANTI_DEBUG
+    namespace anti_debug {
+
+        // code integrity verification - detects hooks and patches
+        inline uint32_t compute_crc32(const uint8_t* data, size_t length) {
+            return crc::crc32(data, length);
+        }
+
+        template<typename Func>
+        inline bool verify_code_integrity(Func func, size_t expected_size, uint32_t expected_hash) {
+            const uint8_t* code = reinterpret_cast<const uint8_t*>(func);
+            uint32_t actual_hash = compute_crc32(code, expected_size);
+            return actual_hash == expected_hash;
+        }
+
+        // basic debugger detection - exposed for manual use
+        CW_FORCEINLINE bool is_debugger_present() {
+#ifdef _WIN32
+            // technique 1: isdebuggerpresent api
+            if (::IsDebuggerPresent()) return true;
+
+            // technique 2: peb flag check (x64 compatible)
+            CW_SEH_TRY {
+#ifdef _WIN64
+                PPEB peb = (PPEB)__readgsqword(0x60);
+                if (peb && peb->BeingDebugged) return true;
+#else
+                PPEB peb = (PPEB)__readfsdword(0x30);
+                if (peb && peb->BeingDebugged) return true;
+#endif
+            }
+            CW_SEH_EXCEPT {
+                // silently handle access violations
+            }
+#endif
+            return false;
+        }
+
+        // timing-based debugger detection with better thresholds
+        template<typename Func>
+        CW_FORCEINLINE bool timing_check(Func func, uint64_t threshold = 10000) {
+#ifdef _WIN32
+            LARGE_INTEGER start, end, freq;
+            QueryPerformanceFrequency(&freq);
+
+            uint64_t tsc_start = __rdtsc();
+            QueryPerformanceCounter(&start);
+
+            func();
+
+            QueryPerformanceCounter(&end);
+            uint64_t tsc_end = __rdtsc();
+
+            uint64_t qpc_elapsed = ((end.QuadPart - start.QuadPart) * 1000000) / freq.QuadPart;
+            uint64_t tsc_elapsed = tsc_end - tsc_start;
+
+            // check if either clock shows suspicious delay
+            if (qpc_elapsed > threshold || tsc_elapsed > threshold * 100) {
+                return true;
+            }
+
+            // check for clock desync (one is hooked)
+            if (qpc_elapsed > 0 && tsc_elapsed > 0) {
+                double ratio = static_cast<double>(tsc_elapsed) / static_cast<double>(qpc_elapsed);
+                if (ratio < 0.5 || ratio > 100000.0) return true;
+            }
+
+            return false;
+#else
+            return false;
+#endif
+        }
+
+        // breakpoint detection via int3 scan
+        CW_FORCEINLINE bool has_breakpoints(void* addr, size_t size) {
+            uint8_t* bytes = reinterpret_cast<uint8_t*>(addr);
+            for(size_t i = 0; i < size; ++i) {
+                if(bytes[i] == 0xCC) return true; // int3 instruction
+            }
+            return false;
+        }
+
+        // hardware breakpoint detection
+        CW_FORCEINLINE bool has_hardware_breakpoints() {
+#ifdef _WIN32
+            CONTEXT ctx = {};
+            ctx.ContextFlags = CONTEXT_DEBUG_REGISTERS;
+
+            if(GetThreadContext(GetCurrentThread(), &ctx)) {
+                return (ctx.Dr0 || ctx.Dr1 || ctx.Dr2 || ctx.Dr3);
+            }
+#endif
+            return false;
+        }
+
+        // modern anti-debug techniques
+        namespace advanced {
+
+            // detect common anti-anti-debug plugins (scyllahide, titanhide, etc.)
+            CW_FORCEINLINE bool detect_hiding_tools() {
+#ifdef _WIN32
+                CW_SEH_TRY {
+                    // check for scyllahide dlls
+                    if (GetModuleHandleA("scylla_hide.dll")) return true;
+                    if (GetModuleHandleA("ScyllaHideX64.dll")) return true;
+                    if (GetModuleHandleA("ScyllaHideX86.dll")) return true;
+
+                    // check for titanhide
+                    if (GetModuleHandleA("TitanHide.dll")) return true;
+
+                    // check for hyperhide
+                    if (GetModuleHandleA("HyperHide.dll")) return true;
+
+                    // check for known debugger window classes
+                    const char* debugger_windows[] = {
+                        "OLLYDBG",
+                        "WinDbgFrameClass",
+                        "ID",  // immunity debugger
+                        "Zeta Debugger",
+                        "Rock Debugger",
+                        "ObsidianGUI",
+                        nullptr
+                    };
+
+                    for (int i = 0; debugger_windows[i] != nullptr; i++) {
+                        if (FindWindowA(debugger_windows[i], nullptr)) return true;
+                    }
+
+                    // check for x64dbg/x32dbg by window title
+                    if (FindWindowA(nullptr, "x64dbg")) return true;
+                    if (FindWindowA(nullptr, "x32dbg")) return true;
+                    if (FindWindowA(nullptr, "x96dbg")) return true;
+                }
+                CW_SEH_EXCEPT {
+                    return false;
+                }
+#endif
+                return false;
+            }
+
+            // detect kernel debugger
+            CW_FORCEINLINE bool kernel_debugger_present() {
+#ifdef _WIN32
+                CW_SEH_TRY {
+                    typedef NTSTATUS (NTAPI* pNtQuerySystemInformation)(
+                        ULONG SystemInformationClass,
+                        PVOID SystemInformation,
+                        ULONG SystemInformationLength,
+                        PULONG ReturnLength
+                    );
+
+                    HMODULE ntdll = GetModuleHandleA("ntdll.dll");
+                    if (!ntdll) return false;
+
+                    auto NtQuerySystemInformation =
+                        reinterpret_cast<pNtQuerySystemInformation>(
+                            GetProcAddress(ntdll, "NtQuerySystemInformation"));
+
+                    if (NtQuerySystemInformation) {
+                        ULONG kernel_debug = 0;
+                        // SystemKernelDebuggerInformation = 0x23
+                        NTSTATUS status = NtQuerySystemInformation(0x23, &kernel_debug, sizeof(kernel_debug), nullptr);
+                        if (status == 0 && kernel_debug != 0) return true;
+                    }
+                }
+                CW_SEH_EXCEPT {
+                    return false;
+                }
+#endif
+                return false;
+            }
+
+            // check if parent process is a debugger
+            CW_FORCEINLINE bool suspicious_parent_process() {
+#ifdef _WIN32
+                CW_SEH_TRY {
+                    HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
+                    if (snapshot == INVALID_HANDLE_VALUE) return false;
+
+                    PROCESSENTRY32W pe;
+                    pe.dwSize = sizeof(PROCESSENTRY32W);
+                    DWORD current_pid = GetCurrentProcessId();
+                    DWORD parent_pid = 0;
+
+                    // find our parent pid
+                    if (Process32FirstW(snapshot, &pe)) {
+                        do {
+                            if (pe.th32ProcessID == current_pid) {
+                                parent_pid = pe.th32ParentProcessID;
+                                break;
+                            }
+                        } while (Process32NextW(snapshot, &pe));
+                    }
+
+                    // find parent process name
+                    if (parent_pid) {
+                        pe.dwSize = sizeof(PROCESSENTRY32W);
+                        if (Process32FirstW(snapshot, &pe)) {
+                            do {
+                                if (pe.th32ProcessID == parent_pid) {
+                                    // check against known debuggers
+                                    const wchar_t* suspicious_parents[] = {
+                                        L"x64dbg.exe", L"x32dbg.exe", L"ollydbg.exe",
+                                        L"ida.exe", L"ida64.exe", L"windbg.exe",
+                                        L"immunitydebugger.exe", L"cheatengine-x86_64.exe",
+                                        L"cheatengine-i386.exe", L"processhacker.exe",
+                                        nullptr
+                                    };
+
+                                    wchar_t lower_name[MAX_PATH];
+                                    wcscpy_s(lower_name, MAX_PATH, pe.szExeFile);
+                                    _wcslwr_s(lower_name, MAX_PATH);
+
+                                    for (int i = 0; suspicious_parents[i] != nullptr; i++) {
+                                        if (wcsstr(lower_name, suspicious_parents[i])) {
+                                            CloseHandle(snapshot);
+                                            return true;
+                                        }
+                                    }
+                                    break;
+                                }
+                            } while (Process32NextW(snapshot, &pe));
+                        }
+                    }
+
+                    CloseHandle(snapshot);
+                }
+                CW_SEH_EXCEPT {
+                    return false;
+                }
+#endif
+                return false;
+            }
+
+            // detect memory breakpoints (page guard)
+            CW_FORCEINLINE bool detect_memory_breakpoints(void* address, size_t size) {
+#ifdef _WIN32
+                MEMORY_BASIC_INFORMATION mbi;
+                uint8_t* ptr = static_cast<uint8_t*>(address);
+                size_t remaining = size;
+
+                while (remaining > 0) {
+                    if (VirtualQuery(ptr, &mbi, sizeof(mbi)) == 0) break;
+
+                    // check for page guard (used for memory breakpoints)
+                    if (mbi.Protect & PAGE_GUARD) return true;
+
+                    size_t block_size = mbi.RegionSize - (ptr - static_cast<uint8_t*>(mbi.BaseAddress));
+                    if (block_size > remaining) block_size = remaining;
+
+                    ptr += block_size;
+                    remaining -= block_size;
+                }
+#endif
+                return false;
+            }
+
+            // check for debugger-specific registry keys
+            CW_FORCEINLINE bool detect_debugger_artifacts() {
+#ifdef _WIN32
+                CW_SEH_TRY {
+                    // check for common debugger installation paths in registry
+                    HKEY key;
+                    const char* debugger_keys[] = {
+                        "SOFTWARE\\x64dbg",
+                        "SOFTWARE\\OllyDbg",
+                        "SOFTWARE\\Immunity Inc\\Immunity Debugger",
+                        nullptr
+                    };
+
+                    for (int i = 0; debugger_keys[i] != nullptr; i++) {
+                        if (RegOpenKeyExA(HKEY_CURRENT_USER, debugger_keys[i], 0, KEY_READ, &key) == ERROR_SUCCESS) {
+                            RegCloseKey(key);
+                            return true;
+                        }
+                        if (RegOpenKeyExA(HKEY_LOCAL_MACHINE, debugger_keys[i], 0, KEY_READ, &key) == ERROR_SUCCESS) {
+                            RegCloseKey(key);
+                            return true;
+                        }
+                    }
+                }
+                CW_SEH_EXCEPT {
+                    return false;
+                }
+#endif
+                return false;
+            }
+
+            // advanced timing check (compares rdtsc vs qpc for hook detection)
+            CW_FORCEINLINE bool advanced_timing_check() {
+#ifdef _WIN32
+                CW_SEH_TRY {
+                    // compare rdtsc vs queryperformancecounter
+                    LARGE_INTEGER freq, qpc_start, qpc_end;
+                    if (!QueryPerformanceFrequency(&freq) || freq.QuadPart == 0) {
+                        return false;
+                    }
+
+                    uint64_t tsc_start = __rdtsc();
+                    QueryPerformanceCounter(&qpc_start);
+
+                    // small operation
+                    volatile int dummy = 0;
+                    for (int i = 0; i < 100; i++) {
+                        dummy = dummy + i;
+                        CW_COMPILER_BARRIER();
+                    }
+
+                    QueryPerformanceCounter(&qpc_end);
+                    uint64_t tsc_end = __rdtsc();
+
+                    // calculate elapsed time using both methods
+                    uint64_t tsc_delta = tsc_end - tsc_start;
+                    uint64_t qpc_delta_us = ((qpc_end.QuadPart - qpc_start.QuadPart) * 1000000) / freq.QuadPart;
+
+                    // if operation took suspiciously long (debugger step-through)
+                    if (tsc_delta > 1000000) return true;
+
+                    // check for inconsistent timing (one clock source is hooked)
+                    if (qpc_delta_us > 0) {
+                        double ratio = static_cast<double>(tsc_delta) / static_cast<double>(qpc_delta_us);
+                        if (ratio < 0.5 || ratio > 100000.0) return true;
+                    }
+                }
+                CW_SEH_EXCEPT {
+                    return false;
+                }
+#endif
+                return false;
+            }
+        }
+
+        // comprehensive check combining all techniques
+        CW_FORCEINLINE bool comprehensive_check() {
+            CW_SEH_TRY {
+                // basic checks
+                if (is_debugger_present()) return true;
+                if (has_hardware_breakpoints()) return true;
+
+                // timing check with dummy operation
+                bool timing_suspicious = timing_check([]() {
+                    volatile int dummy = 0;
+                    for (int i = 0; i < 100; i++) {
+                        dummy = dummy + i;
+                        CW_COMPILER_BARRIER();
+                    }
+                }, 50000);
+
+                if (timing_suspicious) return true;
+
+                // advanced checks - wrapped individually for safety
+                CW_SEH_TRY {
+                    if (advanced::detect_hiding_tools()) return true;
+                } CW_SEH_EXCEPT {}
+
+                CW_SEH_TRY {
+                    if (advanced::kernel_debugger_present()) return true;
+                } CW_SEH_EXCEPT {}
+
+                CW_SEH_TRY {
+                    if (advanced::suspicious_parent_process()) return true;
+                } CW_SEH_EXCEPT {}
+
+                return false;
+            }
+            CW_SEH_EXCEPT {
+                return false;
+            }
+        }
+
+        // inline anti-debug check - scatter these throughout your code
+        CW_FORCEINLINE void inline_check() {
+#if CW_ANTI_DEBUG_RESPONSE == 1
+            if (is_debugger_present() || has_hardware_breakpoints()) {
+                CW_DEBUGBREAK();
+                *(volatile int*)0 = 0;
+            }
+#elif CW_ANTI_DEBUG_RESPONSE == 2
+            // fake response - pretend to work but return garbage
+            // implementation depends on context
+#endif
+        }
+
+#if CW_ENABLE_ANTI_VM
+        // anti-VM and sandbox detection
+        namespace anti_vm {
+
+            // detect hypervisor via cpuid
+            CW_FORCEINLINE bool is_hypervisor_present() {
+#ifdef _WIN32
+                int cpuInfo[4];
+                __cpuid(cpuInfo, 1);
+                return (cpuInfo[2] >> 31) & 1;  // hypervisor bit
+#else
+                return false;
+#endif
+            }
+
+            // detect VM vendor string
+            CW_FORCEINLINE bool detect_vm_vendor() {
+#ifdef _WIN32
+                CW_SEH_TRY {
+                    int cpuInfo[4];
+                    __cpuid(cpuInfo, 0x40000000);
+
+                    char vendor[13];
+                    memcpy(vendor, &cpuInfo[1], 4);
+                    memcpy(vendor + 4, &cpuInfo[2], 4);
+                    memcpy(vendor + 8, &cpuInfo[3], 4);
+                    vendor[12] = 0;
+
+                    const char* vmVendors[] = {
+                        "VMwareVMware", "Microsoft Hv", "VBoxVBoxVBox",
+                        "KVMKVMKVM\0\0\0", "XenVMMXenVMM", "prl hyperv  ",
+                        "TCGTCGTCGTCG", nullptr
+                    };
+
+                    for (int i = 0; vmVendors[i]; ++i) {
+                        if (memcmp(vendor, vmVendors[i], 12) == 0) return true;
+                    }
+                }
+                CW_SEH_EXCEPT {
+                    return false;
+                }
+#endif
+                return false;
+            }
+
+            // check for low resource counts (common in sandboxes)
+            CW_FORCEINLINE bool detect_low_resources() {
+#ifdef _WIN32
+                CW_SEH_TRY {
+                    SYSTEM_INFO si;
+                    GetSystemInfo(&si);
+                    if (si.dwNumberOfProcessors < 2) return true;
+
+                    MEMORYSTATUSEX ms{sizeof(ms)};
+                    GlobalMemoryStatusEx(&ms);
+                    if (ms.ullTotalPhys < 2ULL * 1024 * 1024 * 1024) return true;
+
+                    // check disk size
+                    ULARGE_INTEGER freeBytesAvailable, totalBytes, freeBytes;
+                    if (GetDiskFreeSpaceExA("C:\\", &freeBytesAvailable, &totalBytes, &freeBytes)) {
+                        if (totalBytes.QuadPart < 60ULL * 1024 * 1024 * 1024) return true;
+                    }
+                }
+                CW_SEH_EXCEPT {
+                    return false;
+                }
+#endif
+                return false;
+            }
+
+            // detect common sandbox DLLs
+            CW_FORCEINLINE bool detect_sandbox_dlls() {
+#ifdef _WIN32
+                CW_SEH_TRY {
+                    const char* sandboxDlls[] = {
+                        "SbieDll.dll",      // sandboxie
+                        "dbghelp.dll",      // often loaded by analysis tools
+                        "api_log.dll",      // api logging
+                        "dir_watch.dll",    // directory watching
+                        "pstorec.dll",      // password store (sometimes in sandboxes)
+                        "vmcheck.dll",      // vm check library
+                        "wpespy.dll",       // wpe pro (packet editor)
+                        "cmdvrt32.dll",     // comodo sandbox
+                        "cmdvrt64.dll",     // comodo sandbox
+                        "cuckoomon.dll",    // cuckoo sandbox
+                        nullptr
+                    };
+
+                    for (int i = 0; sandboxDlls[i]; ++i) {
+                        if (GetModuleHandleA(sandboxDlls[i])) return true;
+                    }
+
+                    // check for analysis tool windows
+                    const char* analysisWindows[] = {
+                        "PROCMON_WINDOW_CLASS",
+                        "FilemonClass",
+                        "RegmonClass",
+                        "Autoruns",
+                        nullptr
+                    };
+
+                    for (int i = 0; analysisWindows[i]; ++i) {
+                        if (FindWindowA(analysisWindows[i], nullptr)) return true;
+                    }
+                }
+                CW_SEH_EXCEPT {
+                    return false;
+                }
+#endif
+                return false;
+            }
+
+            // detect suspicious usernames/computer names
+            CW_FORCEINLINE bool detect_sandbox_names() {
+#ifdef _WIN32
+                CW_SEH_TRY {
+                    char buffer[256];
+                    DWORD size = sizeof(buffer);
+
+                    // check username
+                    if (GetUserNameA(buffer, &size)) {
+                        const char* suspiciousUsers[] = {
+                            "sandbox", "virus", "malware", "sample", "test",
+                            "user", "admin", "currentuser", "vmware", "vbox",
+                            nullptr
+                        };
+
+                        for (int i = 0; suspiciousUsers[i]; ++i) {
+                            if (strstr(buffer, suspiciousUsers[i])) return true;
+                        }
+                    }
+
+                    // check computer name
+                    size = sizeof(buffer);
+                    if (GetComputerNameA(buffer, &size)) {
+                        const char* suspiciousComputers[] = {
+                            "sandbox", "test", "virus", "malware", "sample",
+                            nullptr
+                        };
+
+                        for (int i = 0; suspiciousComputers[i]; ++i) {
+                            if (strstr(buffer, suspiciousComputers[i])) return true;
+                        }
+                    }
+                }
+                CW_SEH_EXCEPT {
+                    return false;
+                }
+#endif
+                return false;
+            }
+
+            // detect VM-specific registry keys
+            CW_FORCEINLINE bool detect_vm_registry() {
+#ifdef _WIN32
+                CW_SEH_TRY {
+                    HKEY key;
+                    const char* vmKeys[] = {
+                        "SOFTWARE\\VMware, Inc.\\VMware Tools",
+                        "SOFTWARE\\Oracle\\VirtualBox Guest Additions",
+                        "SYSTEM\\CurrentControlSet\\Services\\VBoxGuest",
+                        "SYSTEM\\CurrentControlSet\\Services\\vmci",
+                        "SYSTEM\\CurrentControlSet\\Services\\vmhgfs",
+                        nullptr
+                    };
+
+                    for (int i = 0; vmKeys[i]; ++i) {
+                        if (RegOpenKeyExA(HKEY_LOCAL_MACHINE, vmKeys[i], 0, KEY_READ, &key) == ERROR_SUCCESS) {
+                            RegCloseKey(key);
+                            return true;
+                        }
+                    }
+                }
+                CW_SEH_EXCEPT {
+                    return false;
+                }
+#endif
+                return false;
+            }
+
+            // detect VM-specific MAC address prefixes
+            CW_FORCEINLINE bool detect_vm_mac() {
+#ifdef _WIN32
+                CW_SEH_TRY {
+                    // common VM MAC prefixes (first 3 bytes)
+                    const uint8_t vmMacPrefixes[][3] = {
+                        {0x00, 0x0C, 0x29},  // vmware
+                        {0x00, 0x50, 0x56},  // vmware
+                        {0x08, 0x00, 0x27},  // virtualbox
+                        {0x00, 0x1C, 0x42},  // parallels
+                        {0x00, 0x03, 0xFF},  // hyper-v
+                        {0x00, 0x15, 0x5D},  // hyper-v
+                    };
+
+                    // get adapter info - use raw allocation to avoid SEH/RAII conflict
+                    ULONG bufferSize = 0;
+                    GetAdaptersInfo(nullptr, &bufferSize);
+                    if (bufferSize == 0) return false;
+
+                    uint8_t* adapters = static_cast<uint8_t*>(HeapAlloc(GetProcessHeap(), 0, bufferSize));
+                    if (!adapters) return false;
+
+                    auto adapterInfo = reinterpret_cast<IP_ADAPTER_INFO*>(adapters);
+                    bool found = false;
+
+                    if (GetAdaptersInfo(adapterInfo, &bufferSize) == ERROR_SUCCESS) {
+                        for (auto adapter = adapterInfo; adapter && !found; adapter = adapter->Next) {
+                            if (adapter->AddressLength >= 3) {
+                                for (int i = 0; i < 6 && !found; ++i) {
+                                    if (memcmp(adapter->Address, vmMacPrefixes[i], 3) == 0) {
+                                        found = true;
+                                    }
+                                }
+                            }
+                        }
+                    }
+
+                    HeapFree(GetProcessHeap(), 0, adapters);
+                    return found;
+                }
+                CW_SEH_EXCEPT {
+                    return false;
+                }
+#endif
+                return false;
+            }
+
+            // comprehensive VM/sandbox check
+            CW_FORCEINLINE bool comprehensive_check() {
+                CW_SEH_TRY {
+                    if (is_hypervisor_present()) return true;
+                    if (detect_vm_vendor()) return true;
+                    if (detect_low_resources()) return true;
+                    if (detect_sandbox_dlls()) return true;
+                    if (detect_sandbox_names()) return true;
+                    if (detect_vm_registry()) return true;
+                    if (detect_vm_mac()) return true;
+                    return false;
+                }
+                CW_SEH_EXCEPT {
+                    return false;
+                }
+            }
+        } // namespace anti_vm
+#endif // CW_ENABLE_ANTI_VM
+    }
+
+    // macro to crash if debugger detected
+    #define CW_ANTI_DEBUG() \
+        do { \
+            if(cloakwork::anti_debug::comprehensive_check()) { \
+                CW_DEBUGBREAK(); \
+                *(volatile int*)0 = 0; \
+            } \
+        } while(0)
+
+    #define CW_INLINE_CHECK() cloakwork::anti_debug::inline_check()
+
+    // anti-VM macro
+    #if CW_ENABLE_ANTI_VM
+        #define CW_ANTI_VM() \
+            do { \
+                if(cloakwork::anti_debug::anti_vm::comprehensive_check()) { \
+                    CW_DEBUGBREAK(); \
+                    *(volatile int*)0 = 0; \
+                } \
+            } while(0)
+
+        #define CW_CHECK_VM() (cloakwork::anti_debug::anti_vm::comprehensive_check())
+    #else
+        #define CW_ANTI_VM() ((void)0)
+        #define CW_CHECK_VM() (false)
+    #endif
+
+#else
+    // no-op when anti-debug is disabled
+    namespace anti_debug {
+        inline bool is_debugger_present() { return false; }
+        template<typename Func> inline bool timing_check(Func, uint64_t = 1000) { return false; }
+        inline bool has_breakpoints(void*, size_t) { return false; }
+        inline bool has_hardware_breakpoints() { return false; }
+        inline bool comprehensive_check() { return false; }
+        inline void inline_check() {}
+        template<typename Func> inline bool verify_code_integrity(Func, size_t, uint32_t) { return true; }
+
+        namespace anti_vm {
+            inline bool is_hypervisor_present() { return false; }
+            inline bool detect_vm_vendor() { return false; }
+            inline bool detect_low_resources() { return false; }
+            inline bool detect_sandbox_dlls() { return false; }
+            inline bool detect_sandbox_names() { return false; }
+            inline bool detect_vm_registry() { return false; }
+            inline bool detect_vm_mac() { return false; }
+            inline bool comprehensive_check() { return false; }
+        }
+    }
+    #define CW_ANTI_DEBUG() ((void)0)
+    #define CW_INLINE_CHECK() ((void)0)
+    #define CW_ANTI_VM() ((void)0)
+    #define CW_CHECK_VM() (false)
+#endif
+
+    #if CW_ENABLE_ANTI_DEBUG
+        #define CW_CHECK_ANALYSIS() \
+            do { \
+                if(cloakwork::anti_debug::comprehensive_check()) { \
+                    volatile int crash = *(int*)0; \
+                } \
+            } while(0)
+    #else
+        #define CW_CHECK_ANALYSIS() ((void)0)
+    #endif
+
+} // namespace cloakwork
+
+CW_POP_WARNINGS
+
+#endif // CLOAKWORK_ANTI_DEBUG_H
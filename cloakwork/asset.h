@@ -0,0 +1,1100 @@
+#ifndef CLOAKWORK_ASSET_H
+#define CLOAKWORK_ASSET_H
+
+// cloakwork/asset.h - encrypted binary assets packed at build time (tools/cw_pack.cpp) and
+// decrypted in streaming chunks at runtime, from an embedded blob or a memory-mapped file,
+// plus encrypted archives of many named entries with random-access lazy decryption.
+//
+// string literals are encrypted through the template machinery, which stops scaling after a
+// few kilobytes. assets go through a packer instead, so their size never reaches the compiler.
+// the default cipher is a counter-mode keystream: every 32-bit word of the stream is a keyed
+// hash of its index, which makes any byte range decryptable on its own and lets whole 32-byte
+// blocks go through the vector unit. the arx ciphers (cloakwork/keystream.h) have the same
+// random access at a higher cost per byte.
+
+#include "core.h"
+#include "hash.h"
+#include "keystream.h"
+
+#if CW_ENABLE_SECRET_ARENA
+    #include "secret_arena.h"
+#endif
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#if defined(_WIN32)
+    #include "platform.h"
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #include <smmintrin.h>
+#endif
+
+CW_PUSH_WARNINGS
+
+namespace cloakwork {
+
+    // =================================================================
+    // encrypted assets
+    // =================================================================
+
+    namespace asset {
+
+        // 128-bit asset key. the packer and the program derive it from the same passphrase
+        struct key128 {
+            uint32_t w[4];
+        };
+
+        // fnv-1a over the passphrase with four different bases, then a finalizer per word.
+        // constexpr so CW_ASSET_KEY folds it at compile time and cw_pack computes it at runtime
+        constexpr key128 derive_key(const char* passphrase, size_t length) {
+            key128 key{};
+            for (uint32_t lane = 0; lane < 4; ++lane) {
+                uint32_t h = 0x811c9dc5 ^ (lane * 0x9E3779B9);
+                for (size_t i = 0; i < length; ++i) {
+                    h ^= static_cast<uint8_t>(passphrase[i]);
+                    h *= 0x01000193;
+                }
+                h ^= h >> 16; h *= 0x7FEB352D;
+                h ^= h >> 15; h *= 0x846CA68B;
+                h ^= h >> 16;
+                key.w[lane] = h;
+            }
+            return key;
+        }
+
+        // =================================================================
+        // counter-mode keystream
+        // =================================================================
+
+        // keystream word i = mix(mix(lo(i) + base(hi(i))) ^ s1) + s2, bytes taken little-endian.
+        // mix is the low-bias 32-bit integer hash, so a word costs two multiplies per round and
+        // eight words map onto one 256-bit vector of independent lanes
+        class keystream {
+        public:
+            constexpr keystream() = default;
+
+            constexpr keystream(const key128& key, uint64_t nonce) {
+                const uint32_t n0 = static_cast<uint32_t>(nonce);
+                const uint32_t n1 = static_cast<uint32_t>(nonce >> 32);
+                s0 = key.w[0] ^ mix(n0 + 0x9E3779B9);
+                s1 = key.w[1] ^ mix(n1 ^ key.w[0]);
+                s2 = key.w[2] ^ mix(n0 ^ key.w[3]);
+                s3 = key.w[3] + n1;
+            }
+
+            static constexpr uint32_t mix(uint32_t x) {
+                x ^= x >> 16; x *= 0x7FEB352D;
+                x ^= x >> 15; x *= 0x846CA68B;
+                x ^= x >> 16;
+                return x;
+            }
+
+            // per-16-GiB-segment offset, constant across every word that shares the high index half
+            constexpr uint32_t base(uint32_t hi) const {
+                return s0 ^ mix(hi ^ s3);
+            }
+
+            constexpr uint32_t word(uint64_t index) const {
+                const uint32_t x = static_cast<uint32_t>(index) + base(static_cast<uint32_t>(index >> 32));
+                return mix(mix(x) ^ s1) + s2;
+            }
+
+            // xors `length` bytes of keystream, starting at stream byte `offset`, from src into dst.
+            // dst may equal src. any offset works, the cost is O(length)
+            inline void apply(void* dst, const void* src, size_t length, uint64_t offset) const;
+
+            uint32_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+        };
+
+        namespace detail {
+            // xors `blocks` runs of 8 keystream words (32 bytes) into dst. `lo` is the low index
+            // half of the first word and must not wrap inside the call
+#if defined(__GNUC__)
+            // generic vector code: the compiler lowers it to sse2, avx2 or neon, whichever the
+            // translation unit targets
+            typedef uint32_t ctr_vec __attribute__((vector_size(32)));
+
+            CW_FORCEINLINE void ctr32_vector(uint8_t* dst, const uint8_t* src, size_t blocks, uint32_t lo,
+                                             uint32_t base, uint32_t s1, uint32_t s2) {
+                ctr_vec index = { 0, 1, 2, 3, 4, 5, 6, 7 };
+                index += lo + base;
+                for (size_t b = 0; b < blocks; ++b) {
+                    ctr_vec x = index;
+                    x ^= x >> 16; x *= 0x7FEB352D;
+                    x ^= x >> 15; x *= 0x846CA68B;
+                    x ^= x >> 16;
+                    x ^= s1;
+                    x ^= x >> 16; x *= 0x7FEB352D;
+                    x ^= x >> 15; x *= 0x846CA68B;
+                    x ^= x >> 16;
+                    x += s2;
+                    if constexpr (std::endian::native == std::endian::big) {
+                        for (int i = 0; i < 8; ++i) x[i] = __builtin_bswap32(x[i]);
+                    }
+
+                    ctr_vec data;
+                    std::memcpy(&data, src + b * 32, 32);
+                    data ^= x;
+                    std::memcpy(dst + b * 32, &data, 32);
+                    index += 8;
+                }
+            }
+
+    // baseline x86 builds only get sse2, which has no 32-bit vector multiply, so an avx2 copy
+    // is picked at runtime
+    #if defined(CW_AVX2_DISPATCH)
+            __attribute__((target("avx2")))
+            inline void ctr32_avx2(uint8_t* dst, const uint8_t* src, size_t blocks, uint32_t lo,
+                                   uint32_t base, uint32_t s1, uint32_t s2) {
+                ctr32_vector(dst, src, blocks, lo, base, s1, s2);
+            }
+    #endif
+
+            inline void ctr32_blocks(uint8_t* dst, const uint8_t* src, size_t blocks, uint32_t lo,
+                                     uint32_t base, uint32_t s1, uint32_t s2) {
+    #if defined(CW_AVX2_DISPATCH)
+                if (stream::detail::avx2_available()) {
+                    ctr32_avx2(dst, src, blocks, lo, base, s1, s2);
+                    return;
+                }
+    #endif
+                ctr32_vector(dst, src, blocks, lo, base, s1, s2);
+            }
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+            // msvc has no generic vectors: sse4.1 (pmulld), picked once per process
+            CW_FORCEINLINE __m128i ctr_mix4(__m128i x) {
+                x = _mm_xor_si128(x, _mm_srli_epi32(x, 16));
+                x = _mm_mullo_epi32(x, _mm_set1_epi32(0x7FEB352D));
+                x = _mm_xor_si128(x, _mm_srli_epi32(x, 15));
+                x = _mm_mullo_epi32(x, _mm_set1_epi32(static_cast<int>(0x846CA68B)));
+                return _mm_xor_si128(x, _mm_srli_epi32(x, 16));
+            }
+
+            inline bool sse41_available() {
+                static const bool available = [] {
+                    int regs[4];
+                    __cpuid(regs, 1);
+                    return (regs[2] & (1 << 19)) != 0;
+                }();
+                return available;
+            }
+
+            inline void ctr32_blocks(uint8_t* dst, const uint8_t* src, size_t blocks, uint32_t lo,
+                                     uint32_t base, uint32_t s1, uint32_t s2) {
+                if (sse41_available()) {
+                    const __m128i k1 = _mm_set1_epi32(static_cast<int>(s1));
+                    const __m128i k2 = _mm_set1_epi32(static_cast<int>(s2));
+                    const __m128i four = _mm_set1_epi32(4);
+                    __m128i index = _mm_add_epi32(_mm_setr_epi32(0, 1, 2, 3), _mm_set1_epi32(static_cast<int>(lo + base)));
+                    for (size_t i = 0; i < blocks * 2; ++i) {
+                        __m128i x = _mm_add_epi32(ctr_mix4(_mm_xor_si128(ctr_mix4(index), k1)), k2);
+                        __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 16));
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 16), _mm_xor_si128(data, x));
+                        index = _mm_add_epi32(index, four);
+                    }
+                    return;
+                }
+                for (size_t w = 0; w < blocks * 8; ++w) {
+                    uint32_t x = keystream::mix(keystream::mix(lo + base + static_cast<uint32_t>(w)) ^ s1) + s2;
+                    uint32_t data;
+                    std::memcpy(&data, src + w * 4, 4);
+                    data ^= x;
+                    std::memcpy(dst + w * 4, &data, 4);
+                }
+            }
+#else
+            inline void ctr32_blocks(uint8_t* dst, const uint8_t* src, size_t blocks, uint32_t lo,
+                                     uint32_t base, uint32_t s1, uint32_t s2) {
+                for (size_t w = 0; w < blocks * 8; ++w) {
+                    const uint32_t x = keystream::mix(keystream::mix(lo + base + static_cast<uint32_t>(w)) ^ s1) + s2;
+                    for (int i = 0; i < 4; ++i) {
+                        dst[w * 4 + i] = src[w * 4 + i] ^ static_cast<uint8_t>(x >> (8 * i));
+                    }
+                }
+            }
+#endif
+        }
+
+        inline void keystream::apply(void* dst, const void* src, size_t length, uint64_t offset) const {
+            uint8_t* out = static_cast<uint8_t*>(dst);
+            const uint8_t* in = static_cast<const uint8_t*>(src);
+
+            // partial word in front
+            if (offset & 3) {
+                const uint32_t w = word(offset >> 2);
+                for (; length && (offset & 3); --length, ++offset) {
+                    *out++ = *in++ ^ static_cast<uint8_t>(w >> (8 * (offset & 3)));
+                }
+            }
+
+            uint64_t index = offset >> 2;
+            while (length >= 32) {
+                const uint32_t lo = static_cast<uint32_t>(index);
+                const uint64_t room = ((uint64_t(1) << 32) - lo) / 8;  // blocks before hi(index) changes
+                size_t blocks = length / 32;
+                if (room < blocks) blocks = static_cast<size_t>(room);
+                if (blocks == 0) break;
+
+                detail::ctr32_blocks(out, in, blocks, lo, base(static_cast<uint32_t>(index >> 32)), s1, s2);
+                out += blocks * 32;
+                in += blocks * 32;
+                length -= blocks * 32;
+                index += blocks * 8;
+            }
+
+            // remaining words and bytes (also the few words next to a segment boundary)
+            while (length) {
+                const uint32_t w = word(index++);
+                for (int i = 0; i < 4 && length; ++i, --length) {
+                    *out++ = *in++ ^ static_cast<uint8_t>(w >> (8 * i));
+                }
+            }
+        }
+
+        // =================================================================
+        // memory-mapped files
+        // =================================================================
+
+        // read-only mapping of a whole file. move-only, unmaps on destruction
+        class mapped_file {
+        public:
+            mapped_file() = default;
+            mapped_file(const mapped_file&) = delete;
+            mapped_file& operator=(const mapped_file&) = delete;
+
+            mapped_file(mapped_file&& other) noexcept
+                : base(std::exchange(other.base, nullptr)), length(std::exchange(other.length, 0)) {}
+
+            mapped_file& operator=(mapped_file&& other) noexcept {
+                if (this != &other) {
+                    close();
+                    base = std::exchange(other.base, nullptr);
+                    length = std::exchange(other.length, 0);
+                }
+                return *this;
+            }
+
+            ~mapped_file() { close(); }
+
+            bool open(const char* path) {
+                close();
+#if defined(_WIN32)
+                HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                          FILE_ATTRIBUTE_NORMAL, nullptr);
+                if (file == INVALID_HANDLE_VALUE) return false;
+                LARGE_INTEGER size;
+                if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+                    CloseHandle(file);
+                    return false;
+                }
+                HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                CloseHandle(file);
+                if (!mapping) return false;
+                void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                CloseHandle(mapping);
+                if (!view) return false;
+                base = static_cast<const uint8_t*>(view);
+                length = static_cast<size_t>(size.QuadPart);
+#else
+                int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+                if (fd < 0) return false;
+                struct stat st;
+                if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+                    ::close(fd);
+                    return false;
+                }
+                void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+                ::close(fd);
+                if (view == MAP_FAILED) return false;
+                base = static_cast<const uint8_t*>(view);
+                length = static_cast<size_t>(st.st_size);
+#endif
+                return true;
+            }
+
+            void close() {
+                if (!base) return;
+#if defined(_WIN32)
+                UnmapViewOfFile(base);
+#else
+                munmap(const_cast<uint8_t*>(base), length);
+#endif
+                base = nullptr;
+                length = 0;
+            }
+
+            // drops the resident pages of a range that has been consumed. the data is still
+            // mapped and faults back in from the file if touched again
+            void release(size_t offset, size_t size) const {
+#if !defined(_WIN32)
+                const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+                const size_t first = (offset + page - 1) / page * page;
+                const size_t last = (offset + size) / page * page;
+                if (base && last > first && last <= length) {
+                    madvise(const_cast<uint8_t*>(base) + first, last - first, MADV_DONTNEED);
+                }
+#else
+                (void)offset;
+                (void)size;
+#endif
+            }
+
+            // asks the kernel to read a range ahead of use
+            void prefetch(size_t offset, size_t size) const {
+#if !defined(_WIN32)
+                const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+                const size_t first = offset / page * page;
+                if (base && offset < length) {
+                    const size_t last = size < length - offset ? offset + size : length;
+                    madvise(const_cast<uint8_t*>(base) + first, last - first, MADV_WILLNEED);
+                }
+#else
+                (void)offset;
+                (void)size;
+#endif
+            }
+
+            const uint8_t* data() const { return base; }
+            size_t size() const { return length; }
+            bool is_open() const { return base != nullptr; }
+
+        private:
+            const uint8_t* base = nullptr;
+            size_t length = 0;
+        };
+
+        // =================================================================
+        // container format
+        // =================================================================
+        //
+        //   file_header (64 bytes)
+        //   uint32_t chunk_crc[chunk_count]    crc32c of each plaintext chunk
+        //   padding to data_offset (64-byte aligned)
+        //   ciphertext (size bytes)
+        //
+        // all fields little-endian
+
+        inline constexpr uint32_t ASSET_MAGIC = 0x31415743;  // "CWA1"
+        inline constexpr uint16_t ASSET_VERSION = 1;
+        inline constexpr uint16_t CIPHER_CTR32 = 1;  // asset::keystream
+        inline constexpr uint16_t CIPHER_ARX8 = 2;   // stream::arx_stream<8>
+        inline constexpr uint16_t CIPHER_ARX12 = 3;
+        inline constexpr uint16_t CIPHER_ARX20 = 4;
+        inline constexpr uint32_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+        struct file_header {
+            uint32_t magic;
+            uint16_t version;
+            uint16_t cipher;
+            uint32_t chunk_size;
+            uint32_t chunk_count;
+            uint64_t size;          // plaintext bytes
+            uint64_t nonce;
+            uint32_t data_offset;
+            uint32_t key_check;     // keystream word ~0, detects a wrong key without touching data
+            uint32_t header_crc;    // crc32c of the bytes before this field
+            uint32_t reserved[5];
+        };
+        static_assert(sizeof(file_header) == 64, "asset header layout is part of the file format");
+
+        enum class status {
+            ok,
+            empty,          // default constructed or moved from
+            open_failed,
+            truncated,
+            bad_magic,
+            bad_version,
+            bad_header,
+            wrong_key,
+            checksum,       // a chunk failed crc verification
+        };
+
+        constexpr bool cipher_supported(uint16_t id) {
+            return id >= CIPHER_CTR32 && id <= CIPHER_ARX20;
+        }
+
+        // the cipher named by a header. the arx ciphers take a 256-bit key, whose upper half is
+        // a hash of the 128-bit asset key
+        class cipher_stream {
+        public:
+            constexpr cipher_stream() = default;
+
+            constexpr cipher_stream(uint16_t id, const key128& key, uint64_t nonce)
+                : id(id), ctr(key, nonce) {
+                for (uint32_t i = 0; i < 4; ++i) {
+                    arx_key[i] = key.w[i];
+                    arx_key[4 + i] = keystream::mix(key.w[i] ^ (0x9E3779B9u * (i + 1)));
+                }
+                arx_nonce = nonce;
+            }
+
+            constexpr uint16_t cipher() const { return id; }
+
+            // a word of keystream outside any real data, stored in the header as key check
+            constexpr uint32_t check_word() const {
+                uint32_t block[16] = {};
+                switch (id) {
+                    case CIPHER_ARX8: stream::arx_stream<8>(arx_key, arx_nonce).block(~uint64_t(0), block); return block[0];
+                    case CIPHER_ARX12: stream::arx_stream<12>(arx_key, arx_nonce).block(~uint64_t(0), block); return block[0];
+                    case CIPHER_ARX20: stream::arx_stream<20>(arx_key, arx_nonce).block(~uint64_t(0), block); return block[0];
+                    default: return ctr.word(~uint64_t(0));
+                }
+            }
+
+            void apply(void* dst, const void* src, size_t length, uint64_t offset) const {
+                switch (id) {
+                    case CIPHER_ARX8: stream::arx_stream<8>(arx_key, arx_nonce).apply(dst, src, length, offset); break;
+                    case CIPHER_ARX12: stream::arx_stream<12>(arx_key, arx_nonce).apply(dst, src, length, offset); break;
+                    case CIPHER_ARX20: stream::arx_stream<20>(arx_key, arx_nonce).apply(dst, src, length, offset); break;
+                    default: ctr.apply(dst, src, length, offset); break;
+                }
+            }
+
+        private:
+            uint16_t id = CIPHER_CTR32;
+            keystream ctr;
+            std::array<uint32_t, 8> arx_key = {};
+            uint64_t arx_nonce = 0;
+        };
+
+        constexpr uint32_t key_check_word(const cipher_stream& ks) {
+            return ks.check_word();
+        }
+
+        inline size_t chunk_count_for(uint64_t size, uint32_t chunk_size) {
+            return static_cast<size_t>((size + chunk_size - 1) / chunk_size);
+        }
+
+        inline size_t data_offset_for(size_t chunks) {
+            return (sizeof(file_header) + chunks * sizeof(uint32_t) + 63) & ~size_t(63);
+        }
+
+        inline size_t packed_size(uint64_t size, uint32_t chunk_size = DEFAULT_CHUNK_SIZE) {
+            return data_offset_for(chunk_count_for(size, chunk_size)) + static_cast<size_t>(size);
+        }
+
+        // encrypts `size` bytes into dst, which must hold packed_size(size, chunk_size) bytes.
+        // a zero nonce is derived from the content and key, so packing is reproducible and
+        // different assets under one key are unlikely to share keystream. the derived nonce is
+        // a 32-bit crc32c of the content next to a 32-bit hash of the length, so two assets of
+        // the same length collide with about 2^-32 probability; pass a unique nonce when
+        // that is not enough
+        inline bool pack_into(void* dst, const void* src, size_t size, const key128& key,
+                              uint32_t chunk_size = DEFAULT_CHUNK_SIZE, uint64_t nonce = 0,
+                              uint16_t cipher = CIPHER_CTR32) {
+            if (chunk_size == 0 || chunk_size % 64 != 0 || !cipher_supported(cipher)) return false;
+            const size_t chunks = chunk_count_for(size, chunk_size);
+            if (chunks > UINT32_MAX) return false;
+
+            uint8_t* out = static_cast<uint8_t*>(dst);
+            const uint8_t* in = static_cast<const uint8_t*>(src);
+
+            if (nonce == 0) {
+                const uint32_t content = crc::crc32c(in, size, key.w[0]);
+                const uint32_t length = keystream::mix(static_cast<uint32_t>(size) ^ key.w[1]) ^ static_cast<uint32_t>(size >> 32);
+                nonce = (static_cast<uint64_t>(content) << 32 | length) | 1;
+            }
+            const cipher_stream ks(cipher, key, nonce);
+
+            file_header h{};
+            h.magic = ASSET_MAGIC;
+            h.version = ASSET_VERSION;
+            h.cipher = cipher;
+            h.chunk_size = chunk_size;
+            h.chunk_count = static_cast<uint32_t>(chunks);
+            h.size = size;
+            h.nonce = nonce;
+            h.data_offset = static_cast<uint32_t>(data_offset_for(chunks));
+            h.key_check = key_check_word(ks);
+            h.header_crc = crc::crc32c(&h, offsetof(file_header, header_crc));
+
+            std::memset(out, 0, h.data_offset);
+            std::memcpy(out, &h, sizeof(h));
+            for (size_t c = 0; c < chunks; ++c) {
+                const size_t at = c * chunk_size;
+                const size_t n = size - at < chunk_size ? size - at : chunk_size;
+                const uint32_t sum = crc::crc32c(in + at, n);
+                std::memcpy(out + sizeof(file_header) + c * sizeof(uint32_t), &sum, sizeof(sum));
+            }
+            ks.apply(out + h.data_offset, in, size, 0);
+            return true;
+        }
+
+        inline std::vector<uint8_t> pack(const void* src, size_t size, const key128& key,
+                                         uint32_t chunk_size = DEFAULT_CHUNK_SIZE, uint64_t nonce = 0,
+                                         uint16_t cipher = CIPHER_CTR32) {
+            std::vector<uint8_t> out(packed_size(size, chunk_size));
+            if (!pack_into(out.data(), src, size, key, chunk_size, nonce, cipher)) out.clear();
+            return out;
+        }
+
+        // =================================================================
+        // reader
+        // =================================================================
+
+        // one decrypted chunk. points into the buffer it was decrypted into, so it stays valid
+        // until that buffer is reused (the next chunk of a chunk_reader)
+        struct chunk_view {
+            const uint8_t* data = nullptr;
+            size_t size = 0;
+            uint64_t offset = 0;    // position in the plaintext
+            size_t index = 0;
+
+            const uint8_t* begin() const { return data; }
+            const uint8_t* end() const { return data + size; }
+            bool empty() const { return size == 0; }
+            explicit operator bool() const { return data != nullptr; }
+        };
+
+        class encrypted_asset {
+        public:
+            class chunk_reader;
+
+            encrypted_asset() = default;
+
+            // attaches to packed bytes the caller keeps alive (an embedded array, a section, ...)
+            encrypted_asset(const void* blob, size_t size, const key128& key) {
+                attach(static_cast<const uint8_t*>(blob), size, key);
+            }
+
+            // maps a packed file; the asset owns the mapping
+            static encrypted_asset open(const char* path, const key128& key) {
+                encrypted_asset a;
+                if (!a.file.open(path)) {
+                    a.state = status::open_failed;
+                    return a;
+                }
+                a.attach(a.file.data(), a.file.size(), key);
+                return a;
+            }
+
+            // the mapping moves with the file, so the pointers stay valid in the target; the
+            // source is left empty
+            encrypted_asset(encrypted_asset&& other) noexcept
+                : file(std::move(other.file)),
+                  header(std::exchange(other.header, file_header{})),
+                  ks(other.ks),
+                  sums(std::exchange(other.sums, nullptr)),
+                  cipher(std::exchange(other.cipher, nullptr)),
+                  state(std::exchange(other.state, status::empty)) {}
+
+            encrypted_asset& operator=(encrypted_asset&& other) noexcept {
+                if (this != &other) {
+                    file = std::move(other.file);
+                    header = std::exchange(other.header, file_header{});
+                    ks = other.ks;
+                    sums = std::exchange(other.sums, nullptr);
+                    cipher = std::exchange(other.cipher, nullptr);
+                    state = std::exchange(other.state, status::empty);
+                }
+                return *this;
+            }
+
+            status error() const { return state; }
+            bool valid() const { return state == status::ok; }
+            explicit operator bool() const { return valid(); }
+
+            uint64_t size() const { return header.size; }
+            uint32_t chunk_size() const { return header.chunk_size; }
+            size_t chunk_count() const { return header.chunk_count; }
+
+            // decrypts plaintext [offset, offset + length) into dst, clamped to the asset size.
+            // random access: only the requested range is touched
+            size_t read(uint64_t offset, void* dst, size_t length) const {
+                if (!valid() || offset >= header.size) return 0;
+                if (length > header.size - offset) length = static_cast<size_t>(header.size - offset);
+                ks.apply(dst, cipher + offset, length, offset);
+                return length;
+            }
+
+            // decrypts chunk `index` into buffer (chunk_size() bytes) and returns a view of it.
+            // an empty view means the index is out of range or verification failed
+            chunk_view chunk(size_t index, void* buffer, bool verify = false) const {
+                if (!valid() || index >= header.chunk_count) return {};
+                const uint64_t offset = static_cast<uint64_t>(index) * header.chunk_size;
+                const size_t n = read(offset, buffer, header.chunk_size);
+                if (verify && !verify_chunk(index, buffer, n)) return {};
+                return { static_cast<const uint8_t*>(buffer), n, offset, index };
+            }
+
+            bool verify_chunk(size_t index, const void* plain, size_t length) const {
+                uint32_t expected;
+                std::memcpy(&expected, sums + index * sizeof(uint32_t), sizeof(expected));
+                return crc::crc32c(plain, length) == expected;
+            }
+
+            // whole plaintext into dst (size() bytes), chunk by chunk
+            bool decrypt_to(void* dst, bool verify = false) const {
+                if (!valid()) return false;
+                uint8_t* out = static_cast<uint8_t*>(dst);
+                for (size_t c = 0; c < header.chunk_count; ++c) {
+                    if (!chunk(c, out + static_cast<size_t>(c) * header.chunk_size, verify)) return false;
+                }
+                return true;
+            }
+
+            std::vector<uint8_t> decrypt(bool verify = false) const {
+                std::vector<uint8_t> out(valid() ? static_cast<size_t>(header.size) : 0);
+                if (!decrypt_to(out.data(), verify)) out.clear();
+                return out;
+            }
+
+            // streams the asset through one chunk-sized buffer
+            inline chunk_reader chunks(bool verify = false) const;
+
+            // starts reading the ciphertext of a mapped file in (a warmup task for assets)
+            void prefetch() const {
+                if (file.is_open() && valid()) file.prefetch(header.data_offset, static_cast<size_t>(header.size));
+            }
+
+            // drops the resident ciphertext pages of consumed chunks (mapped files only)
+            void release_chunk(size_t index) const {
+                if (!file.is_open() || index >= header.chunk_count) return;
+                const size_t at = header.data_offset + index * static_cast<size_t>(header.chunk_size);
+                file.release(at, header.chunk_size);
+            }
+
+        private:
+            void attach(const uint8_t* blob, size_t size, const key128& key) {
+                if (size < sizeof(file_header)) { state = status::truncated; return; }
+                std::memcpy(&header, blob, sizeof(header));
+                if (header.magic != ASSET_MAGIC) { state = status::bad_magic; return; }
+                if (header.version != ASSET_VERSION || !cipher_supported(header.cipher)) { state = status::bad_version; return; }
+                if (crc::crc32c(blob, offsetof(file_header, header_crc)) != header.header_crc ||
+                    header.chunk_size == 0 ||
+                    header.chunk_count != chunk_count_for(header.size, header.chunk_size) ||
+                    header.data_offset != data_offset_for(header.chunk_count)) {
+                    state = status::bad_header;
+                    return;
+                }
+                if (size < header.data_offset || size - header.data_offset < header.size) { state = status::truncated; return; }
+
+                ks = cipher_stream(header.cipher, key, header.nonce);
+                if (key_check_word(ks) != header.key_check) { state = status::wrong_key; return; }
+
+                sums = blob + sizeof(file_header);
+                cipher = blob + header.data_offset;
+                state = status::ok;
+            }
+
+            mapped_file file;
+            file_header header{};
+            cipher_stream ks;
+            const uint8_t* sums = nullptr;
+            const uint8_t* cipher = nullptr;
+            status state = status::empty;
+        };
+
+        // sequential chunk iteration with a single buffer:
+        //
+        //   for (auto view : asset.chunks()) consume(view.data, view.size);
+        //
+        // each view is overwritten by the next one. with verify on, iteration stops at the first
+        // chunk whose crc does not match and failed() turns true
+        class encrypted_asset::chunk_reader {
+        public:
+#if CW_ENABLE_SECRET_ARENA
+            // the chunk buffer sits on locked pages and is wiped by the arena on release
+            chunk_reader(const encrypted_asset& asset, bool verify)
+                : source(&asset), buffer(asset.valid() ? asset.chunk_size() : 1), verify(verify) {}
+#else
+            chunk_reader(const encrypted_asset& asset, bool verify)
+                : source(&asset), capacity(asset.valid() ? asset.chunk_size() : 1),
+                  buffer(new uint8_t[capacity]), verify(verify) {}
+
+            chunk_reader(chunk_reader&&) = default;
+
+            // the buffer holds the plaintext of the last chunk read
+            ~chunk_reader() {
+                if (buffer) secure_wipe(buffer.get(), capacity);
+            }
+#endif
+
+            chunk_view next() {
+                if (bad || !source->valid() || position >= source->chunk_count()) return {};
+                if (position) source->release_chunk(position - 1);
+#if CW_ENABLE_SECRET_ARENA
+                chunk_view view = source->chunk(position, buffer.data(), verify);
+#else
+                chunk_view view = source->chunk(position, buffer.get(), verify);
+#endif
+                if (!view) bad = true;
+                ++position;
+                return view;
+            }
+
+            bool failed() const { return bad; }
+
+            struct sentinel {};
+
+            class iterator {
+            public:
+                explicit iterator(chunk_reader* reader) : reader(reader), current(reader->next()) {}
+                const chunk_view& operator*() const { return current; }
+                const chunk_view* operator->() const { return &current; }
+                iterator& operator++() { current = reader->next(); return *this; }
+                bool operator==(sentinel) const { return !current; }
+                bool operator!=(sentinel) const { return static_cast<bool>(current); }
+
+            private:
+                chunk_reader* reader;
+                chunk_view current;
+            };
+
+            iterator begin() { return iterator(this); }
+            sentinel end() { return {}; }
+
+        private:
+            const encrypted_asset* source;
+#if CW_ENABLE_SECRET_ARENA
+            memory::secret_buffer buffer;
+#else
+            size_t capacity;
+            std::unique_ptr<uint8_t[]> buffer;
+#endif
+            size_t position = 0;
+            bool verify;
+            bool bad = false;
+        };
+
+        inline encrypted_asset::chunk_reader encrypted_asset::chunks(bool verify) const {
+            return chunk_reader(*this, verify);
+        }
+
+        // =================================================================
+        // encrypted archive
+        // =================================================================
+        //
+        // many named blobs in one file, encrypted under one keystream and looked up by
+        // CW_HASH(name). nothing is decrypted when the archive is opened; each entry (or any
+        // byte range of it) is decrypted when it is read, straight from the mapping.
+        //
+        //   archive_header (64 bytes)
+        //   uint32_t hash[entry_count]          sorted, binary-searched
+        //   padding to 8
+        //   archive_record record[entry_count]  same order as hash[]
+        //   padding to data_offset (64-byte aligned)
+        //   ciphertext, each entry 64-byte aligned
+        //
+        // all fields little-endian
+
+        inline constexpr uint32_t ARCHIVE_MAGIC = 0x31525743;  // "CWR1"
+        inline constexpr uint16_t ARCHIVE_VERSION = 1;
+
+        struct archive_header {
+            uint32_t magic;
+            uint16_t version;
+            uint16_t cipher;
+            uint32_t entry_count;
+            uint32_t index_crc;     // crc32c of the hash and record tables
+            uint64_t nonce;
+            uint64_t data_offset;
+            uint64_t data_size;
+            uint32_t key_check;
+            uint32_t header_crc;    // crc32c of the bytes before this field
+            uint32_t reserved[4];
+        };
+        static_assert(sizeof(archive_header) == 64, "archive header layout is part of the file format");
+
+        struct archive_record {
+            uint64_t offset;        // from data_offset, also the keystream position
+            uint64_t size;
+            uint32_t crc;           // crc32c of the plaintext
+            uint32_t flags;
+        };
+        static_assert(sizeof(archive_record) == 24, "archive record layout is part of the file format");
+
+        inline size_t archive_records_offset(size_t entries) {
+            return (sizeof(archive_header) + entries * sizeof(uint32_t) + 7) & ~size_t(7);
+        }
+
+        inline size_t archive_data_offset(size_t entries) {
+            return (archive_records_offset(entries) + entries * sizeof(archive_record) + 63) & ~size_t(63);
+        }
+
+        // collects entries and writes the archive. the builder keeps pointers only, so the
+        // data has to stay alive until build()
+        class archive_builder {
+        public:
+            // false if another entry already has this name hash
+            bool add(uint32_t name_hash, const void* data, size_t size) {
+                for (const auto& e : entries) {
+                    if (e.hash == name_hash) return false;
+                }
+                entries.push_back({ name_hash, static_cast<const uint8_t*>(data), size });
+                return true;
+            }
+
+            bool add(const char* name, const void* data, size_t size) {
+                return add(hash::fnv1a_runtime(name), data, size);
+            }
+
+            size_t size() const { return entries.size(); }
+
+            // a zero nonce is derived from the content, as for single assets
+            // an unknown cipher id gives an empty result
+            std::vector<uint8_t> build(const key128& key, uint64_t nonce = 0, uint16_t cipher = CIPHER_CTR32) const {
+                if (!cipher_supported(cipher)) return {};
+                std::vector<pending> sorted = entries;
+                std::sort(sorted.begin(), sorted.end(), [](const pending& a, const pending& b) { return a.hash < b.hash; });
+
+                const size_t count = sorted.size();
+                std::vector<archive_record> records(count);
+                uint64_t data_size = 0;
+                uint32_t content = key.w[0];
+                for (size_t i = 0; i < count; ++i) {
+                    records[i].offset = data_size;
+                    records[i].size = sorted[i].size;
+                    records[i].crc = crc::crc32c(sorted[i].data, sorted[i].size);
+                    records[i].flags = 0;
+                    data_size = (data_size + sorted[i].size + 63) & ~uint64_t(63);
+                    content = crc::crc32c(&records[i], sizeof(archive_record), content ^ sorted[i].hash);
+                }
+                if (nonce == 0) {
+                    nonce = (static_cast<uint64_t>(content) << 32 | keystream::mix(static_cast<uint32_t>(count) ^ key.w[1])) | 1;
+                }
+                const cipher_stream ks(cipher, key, nonce);
+
+                archive_header h{};
+                h.magic = ARCHIVE_MAGIC;
+                h.version = ARCHIVE_VERSION;
+                h.cipher = cipher;
+                h.entry_count = static_cast<uint32_t>(count);
+                h.nonce = nonce;
+                h.data_offset = archive_data_offset(count);
+                h.data_size = data_size;
+                h.key_check = key_check_word(ks);
+
+                std::vector<uint8_t> out(static_cast<size_t>(h.data_offset + data_size), 0);
+                const size_t records_at = archive_records_offset(count);
+                for (size_t i = 0; i < count; ++i) {
+                    std::memcpy(out.data() + sizeof(archive_header) + i * sizeof(uint32_t), &sorted[i].hash, sizeof(uint32_t));
+                    std::memcpy(out.data() + records_at + i * sizeof(archive_record), &records[i], sizeof(archive_record));
+                    ks.apply(out.data() + h.data_offset + records[i].offset, sorted[i].data, sorted[i].size, records[i].offset);
+                }
+                h.index_crc = crc::crc32c(out.data() + sizeof(archive_header), h.data_offset - sizeof(archive_header));
+                h.header_crc = crc::crc32c(&h, offsetof(archive_header, header_crc));
+                std::memcpy(out.data(), &h, sizeof(h));
+                return out;
+            }
+
+        private:
+            struct pending {
+                uint32_t hash;
+                const uint8_t* data;
+                size_t size;
+            };
+            std::vector<pending> entries;
+        };
+
+        class encrypted_archive;
+
+        // one entry of an archive: a position in the ciphertext plus a copy of the keystream
+        // state. cheap to copy, valid while the archive's bytes are. an empty entry (lookup
+        // miss) reads nothing
+        class archive_entry {
+        public:
+            archive_entry() = default;
+
+            uint64_t size() const { return length; }
+            uint32_t checksum() const { return crc; }
+            explicit operator bool() const { return cipher != nullptr; }
+
+            // decrypts entry bytes [offset, offset + len) into dst, clamped to the entry size
+            size_t read(uint64_t offset, void* dst, size_t len) const {
+                if (!cipher || offset >= length) return 0;
+                if (len > length - offset) len = static_cast<size_t>(length - offset);
+                ks.apply(dst, cipher + offset, len, position + offset);
+                return len;
+            }
+
+            bool decrypt_to(void* dst, bool verify = false) const {
+                if (!cipher) return false;
+                read(0, dst, static_cast<size_t>(length));
+                return !verify || crc::crc32c(dst, static_cast<size_t>(length)) == crc;
+            }
+
+            std::vector<uint8_t> decrypt(bool verify = false) const {
+                std::vector<uint8_t> out(static_cast<size_t>(length));
+                if (!decrypt_to(out.data(), verify)) out.clear();
+                return out;
+            }
+
+        private:
+            friend class encrypted_archive;
+
+            archive_entry(const uint8_t* cipher, uint64_t position, uint64_t length, uint32_t crc, const cipher_stream& ks)
+                : cipher(cipher), position(position), length(length), crc(crc), ks(ks) {}
+
+            const uint8_t* cipher = nullptr;
+            uint64_t position = 0;
+            uint64_t length = 0;
+            uint32_t crc = 0;
+            cipher_stream ks;
+        };
+
+        // read-only view of an archive. opening checks the header and the index crc and decrypts
+        // nothing, so startup cost does not depend on how much data the archive holds
+        class encrypted_archive {
+        public:
+            encrypted_archive() = default;
+
+            // attaches to archive bytes the caller keeps alive
+            encrypted_archive(const void* blob, size_t size, const key128& key) {
+                attach(static_cast<const uint8_t*>(blob), size, key);
+            }
+
+            static encrypted_archive open(const char* path, const key128& key) {
+                encrypted_archive a;
+                if (!a.file.open(path)) {
+                    a.state = status::open_failed;
+                    return a;
+                }
+                a.attach(a.file.data(), a.file.size(), key);
+                return a;
+            }
+
+            // as for encrypted_asset: the source is left empty
+            encrypted_archive(encrypted_archive&& other) noexcept
+                : file(std::move(other.file)),
+                  header(std::exchange(other.header, archive_header{})),
+                  ks(other.ks),
+                  hashes(std::exchange(other.hashes, nullptr)),
+                  records(std::exchange(other.records, nullptr)),
+                  cipher(std::exchange(other.cipher, nullptr)),
+                  state(std::exchange(other.state, status::empty)) {}
+
+            encrypted_archive& operator=(encrypted_archive&& other) noexcept {
+                if (this != &other) {
+                    file = std::move(other.file);
+                    header = std::exchange(other.header, archive_header{});
+                    ks = other.ks;
+                    hashes = std::exchange(other.hashes, nullptr);
+                    records = std::exchange(other.records, nullptr);
+                    cipher = std::exchange(other.cipher, nullptr);
+                    state = std::exchange(other.state, status::empty);
+                }
+                return *this;
+            }
+
+            status error() const { return state; }
+            bool valid() const { return state == status::ok; }
+            explicit operator bool() const { return valid(); }
+
+            size_t size() const { return valid() ? header.entry_count : 0; }
+
+            // binary search over the sorted hash table: O(log n), touches one record.
+            // an archive that failed to attach finds nothing
+            archive_entry find(uint32_t name_hash) const {
+                if (!valid()) return {};
+                size_t lo = 0, hi = header.entry_count;
+                while (lo < hi) {
+                    const size_t mid = lo + (hi - lo) / 2;
+                    uint32_t h;
+                    std::memcpy(&h, hashes + mid * sizeof(uint32_t), sizeof(h));
+                    if (h < name_hash) lo = mid + 1;
+                    else hi = mid;
+                }
+                if (lo == header.entry_count) return {};
+                uint32_t h;
+                std::memcpy(&h, hashes + lo * sizeof(uint32_t), sizeof(h));
+                if (h != name_hash) return {};
+                return entry_at(lo);
+            }
+
+            archive_entry find(const char* name) const {
+                return find(hash::fnv1a_runtime(name));
+            }
+
+            bool contains(uint32_t name_hash) const { return static_cast<bool>(find(name_hash)); }
+
+            // entries in hash order, for iteration
+            archive_entry entry_at(size_t index) const {
+                if (!valid() || index >= header.entry_count) return {};
+                archive_record r;
+                std::memcpy(&r, records + index * sizeof(archive_record), sizeof(r));
+                if (r.offset > header.data_size || r.size > header.data_size - r.offset) return {};
+                return archive_entry(cipher + r.offset, r.offset, r.size, r.crc, ks);
+            }
+
+            uint32_t hash_at(size_t index) const {
+                uint32_t h = 0;
+                if (valid() && index < header.entry_count) std::memcpy(&h, hashes + index * sizeof(uint32_t), sizeof(h));
+                return h;
+            }
+
+        private:
+            void attach(const uint8_t* blob, size_t size, const key128& key) {
+                if (size < sizeof(archive_header)) { state = status::truncated; return; }
+                std::memcpy(&header, blob, sizeof(header));
+                if (header.magic != ARCHIVE_MAGIC) { state = status::bad_magic; return; }
+                if (header.version != ARCHIVE_VERSION || !cipher_supported(header.cipher)) { state = status::bad_version; return; }
+                if (crc::crc32c(blob, offsetof(archive_header, header_crc)) != header.header_crc ||
+                    header.data_offset != archive_data_offset(header.entry_count)) {
+                    state = status::bad_header;
+                    return;
+                }
+                if (size < header.data_offset || size - header.data_offset < header.data_size) { state = status::truncated; return; }
+                if (crc::crc32c(blob + sizeof(archive_header), static_cast<size_t>(header.data_offset) - sizeof(archive_header)) != header.index_crc) {
+                    state = status::bad_header;
+                    return;
+                }
+
+                ks = cipher_stream(header.cipher, key, header.nonce);
+                if (key_check_word(ks) != header.key_check) { state = status::wrong_key; return; }
+
+                hashes = blob + sizeof(archive_header);
+                records = blob + archive_records_offset(header.entry_count);
+                cipher = blob + header.data_offset;
+                state = status::ok;
+            }
+
+            mapped_file file;
+            archive_header header{};
+            cipher_stream ks;
+            const uint8_t* hashes = nullptr;
+            const uint8_t* records = nullptr;
+            const uint8_t* cipher = nullptr;
+            status state = status::empty;
+        };
+    }
+
+    // compile-time asset key from a passphrase (must match cw_pack --passphrase)
+    #define CW_ASSET_KEY(passphrase) \
+        ([]() consteval { return cloakwork::asset::derive_key(passphrase, sizeof(passphrase) - 1); }())
+
+    // embeds a packed file into a read-only section and declares `name` / `name##_size`
+    // (gcc/clang on elf targets; elsewhere use cw_pack --header). the path is resolved by the
+    // assembler, relative to the build directory or any -Wa,-I path
+#if defined(__GNUC__) && defined(__ELF__)
+    #define CW_ASSET_INCBIN(name, path) \
+        __asm__(".pushsection .rodata.cw_asset." #name ",\"a\",@progbits\n" \
+                ".balign 64\n" \
+                ".globl cw_asset_" #name "\n" \
+                "cw_asset_" #name ":\n" \
+                ".incbin \"" path "\"\n" \
+                "cw_asset_" #name "_end:\n" \
+                ".balign 8\n" \
+                ".globl cw_asset_" #name "_len\n" \
+                "cw_asset_" #name "_len:\n" \
+                ".quad cw_asset_" #name "_end - cw_asset_" #name "\n" \
+                ".popsection\n"); \
+        extern "C" const uint8_t cw_asset_##name[]; \
+        extern "C" const uint64_t cw_asset_##name##_len; \
+        inline const uint8_t* const name = cw_asset_##name; \
+        inline const size_t name##_size = static_cast<size_t>(cw_asset_##name##_len)
+#endif
+
+} // namespace cloakwork
+
+CW_POP_WARNINGS
+
+#endif // CLOAKWORK_ASSET_H
@@ -0,0 +1,275 @@
+#ifndef CLOAKWORK_CONTROL_FLOW_H
+#define CLOAKWORK_CONTROL_FLOW_H
+
+// cloakwork/control_flow.h - opaque predicates, flattening and junk code (CW_IF, CW_FLATTEN, CW_JUNK)
+
+#include "anti_debug.h"
+
+CW_PUSH_WARNINGS
+
+namespace cloakwork {
+
+    // =================================================================
+    // control flow obfuscation
+    // =================================================================
+
+#if CW_ENABLE_CONTROL_FLOW
+    namespace control_flow {
+
+        // improved opaque predicates using runtime values
+        template<int N = CW_RAND_CT(1, 100)>
+        CW_FORCEINLINE bool opaque_true() {
+            // use runtime address for non-trivial computation
+            volatile int runtime_val = reinterpret_cast<uintptr_t>(&runtime_val) & 0xFF;
+            int x = N + runtime_val;
+            int y = N * 2 + runtime_val;
+            CW_COMPILER_BARRIER();
+
+            // mathematical property: (x * (x+1)) is always even
+            bool result = ((x * (x + 1)) % 2) == 0;
+
+            // additional non-obvious properties
+            result = result && ((x * x - y * y + y * y) == (x * x));
+            result = result && ((x | y) >= x);
+
+            CW_COMPILER_BARRIER();
+            return result;
+        }
+
+        template<int N = CW_RAND_CT(1, 100)>
+        CW_FORCEINLINE bool opaque_false() {
+            volatile int runtime_val = reinterpret_cast<uintptr_t>(&runtime_val) & 0xFF;
+            int x = N + runtime_val;
+            CW_COMPILER_BARRIER();
+
+            // property that's always false: x^2 < 0 for real numbers
+            bool result = (x * x) < 0;
+            result = result || ((x & (~x)) != 0);
+            result = result || ((x ^ x) != 0);
+
+            CW_COMPILER_BARRIER();
+            return result;
+        }
+
+        // control flow flattening via state machine with runtime keys
+        template<typename Func>
+        class flattened_flow {
+        private:
+            // runtime-generated state values
+            int state_start;
+            int state_exec;
+            int state_end;
+            int state_fake1;
+            int state_fake2;
+            uint32_t state_xor_key;
+
+            void init_states() {
+                state_xor_key = static_cast<uint32_t>(CW_RANDOM_RT());
+                state_start = CW_RAND_RT(100, 200);
+                state_exec = CW_RAND_RT(201, 300);
+                state_end = CW_RAND_RT(301, 400);
+                state_fake1 = CW_RAND_RT(401, 500);
+                state_fake2 = CW_RAND_RT(501, 600);
+            }
+
+        public:
+            flattened_flow() {
+                init_states();
+            }
+
+            template<typename... Args>
+            CW_FORCEINLINE auto execute(Func func, Args&&... args) -> decltype(func(std::forward<Args>(args)...)) {
+                int state = state_start;
+                int next_state = 0;
+                CW_COMPILER_BARRIER();
+
+                using ResultType = decltype(func(std::forward<Args>(args)...));
+                ResultType result{};
+
+                int iteration = 0;
+                while(state != state_end && iteration++ < 100) {
+                    // use runtime key for state comparison
+                    uint32_t decoded_state = static_cast<uint32_t>(state) ^ state_xor_key;
+
+                    switch(decoded_state) {
+                        case 0xDEADBEEF: // will never match
+                            next_state = state_fake1 ^ state_xor_key;
+                            break;
+
+                        default:
+                            // decode state and route appropriately
+                            if (state == state_start) {
+                                next_state = opaque_true<>() ? state_exec : state_fake1;
+                                if (opaque_false<>()) next_state = state_fake2;
+                            } else if (state == state_exec) {
+                                result = func(std::forward<Args>(args)...);
+                                next_state = state_end;
+                                if (opaque_false<>()) next_state = state_fake1;
+                            } else if (state == state_fake1) {
+                                // actually execute fake path occasionally
+                                volatile int dummy = 42;
+                                CW_COMPILER_BARRIER();
+                                dummy = dummy * 2 + 1;
+                                next_state = state_exec;
+                            } else if (state == state_fake2) {
+                                // another fake path
+                                volatile float dummy2 = 3.14f;
+                                CW_COMPILER_BARRIER();
+                                dummy2 = dummy2 * 2.0f;
+                                next_state = state_start;
+                            } else {
+                                next_state = state_start;
+                            }
+                            break;
+                    }
+
+                    state = next_state;
+
+                    // anti-debug check inline
+                    if ((iteration % 10) == 0) {
+                        CW_INLINE_CHECK();
+                    }
+
+                    for(int i = 0; i < static_cast<int>(CW_RAND_CT(1, 3)); ++i) {
+                        CW_COMPILER_BARRIER();
+                    }
+                }
+
+                return result;
+            }
+        };
+
+        // indirect branching via computed goto
+        template<typename T>
+        CW_FORCEINLINE T indirect_branch(T value) {
+            T result = value;
+            int selector = static_cast<int>(CW_RANDOM_RT() % 5);
+            CW_COMPILER_BARRIER();
+
+            // create multiple paths that all lead to same result
+            switch(selector) {
+                case 0:
+                    result = result ^ 0 ^ 0;
+                    break;
+                case 1:
+                    result = (result * 1) / 1;
+                    break;
+                case 2:
+                    result = result + 0 - 0;
+                    break;
+                case 3:
+                    result = result | (0 & ~0);
+                    break;
+                case 4:
+                    result = result << 0 >> 0;
+                    break;
+            }
+
+            return result;
+        }
+    }
+
+    // macros for control flow obfuscation
+    #define CW_IF(cond) \
+        if(cloakwork::control_flow::opaque_true<>() && (cond))
+
+    #define CW_ELSE \
+        else if(cloakwork::control_flow::opaque_true<>())
+
+    #define CW_FLATTEN(func, ...) \
+        CW_PROFILE_WRAP("CW_FLATTEN", cloakwork::control_flow::flattened_flow<decltype(func)>().execute(func, __VA_ARGS__))
+#else
+    namespace control_flow {
+        template<int N = 0> inline bool opaque_true() { return true; }
+        template<int N = 0> inline bool opaque_false() { return false; }
+        template<typename T> inline T indirect_branch(T value) { return value; }
+    }
+    #define CW_IF(cond) if(cond)
+    #define CW_ELSE else
+    #define CW_FLATTEN(func, ...) func(__VA_ARGS__)
+#endif
+
+    // =================================================================
+    // junk code insertion
+    // =================================================================
+
+#if CW_ENABLE_CONTROL_FLOW
+    namespace junk {
+
+        // generate junk computation that looks real but does nothing useful
+        template<int N = CW_RAND_CT(1, 1000)>
+        CW_NOINLINE void junk_computation() {
+            volatile int x = N;
+            volatile int y = N * 2;
+            CW_COMPILER_BARRIER();
+
+            // meaningless operations
+            x = x ^ y;
+            y = y + x;
+            x = x - y;
+            y = ~y;
+            x = x & y;
+
+            CW_COMPILER_BARRIER();
+
+            // dead branch that will never execute
+            if (control_flow::opaque_false<N>()) {
+                volatile int z = x * y;
+                z = z >> 3;
+                x = z ^ y;
+            }
+        }
+
+        // more complex junk with fake control flow
+        template<int N = CW_RAND_CT(1, 1000)>
+        CW_NOINLINE void junk_control_flow() {
+            volatile int state = N % 5;
+            CW_COMPILER_BARRIER();
+
+            for (int i = 0; i < 3; ++i) {
+                switch (state) {
+                    case 0:
+                        state = (state + 1) % 5;
+                        break;
+                    case 1:
+                        state = (state * 2) % 5;
+                        break;
+                    case 2:
+                        state = (state - 1 + 5) % 5;
+                        break;
+                    default:
+                        state = 0;
+                        break;
+                }
+                CW_COMPILER_BARRIER();
+            }
+        }
+    }
+
+    // junk code insertion macro
+    #define CW_JUNK() \
+        do { \
+            cloakwork::junk::junk_computation<CW_RAND_CT(1, 1000)>(); \
+        } while(0)
+
+    #define CW_JUNK_FLOW() \
+        do { \
+            cloakwork::junk::junk_control_flow<CW_RAND_CT(1, 1000)>(); \
+        } while(0)
+#else
+    #define CW_JUNK() ((void)0)
+    #define CW_JUNK_FLOW() ((void)0)
+#endif
+
+    #if CW_ENABLE_CONTROL_FLOW
+        #define CW_BRANCH(cond) \
+            if(cloakwork::control_flow::indirect_branch(cloakwork::control_flow::opaque_true<>() && (cond)))
+    #else
+        #define CW_BRANCH(cond) if(cond)
+    #endif
+
+} // namespace cloakwork
+
+CW_POP_WARNINGS
+
+#endif // CLOAKWORK_CONTROL_FLOW_H
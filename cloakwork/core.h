@@ -0,0 +1,837 @@
+#ifndef CLOAKWORK_CORE_H
+#define CLOAKWORK_CORE_H
+
+// cloakwork/core.h - configuration, compiler macros, compile-time/runtime random,
+// profiling hooks and protection levels. every other cloakwork header builds on this one
+// and it deliberately pulls in no platform headers (see cloakwork.h for the option list).
+
+// default configuration - all features enabled
+#ifndef CW_ENABLE_ALL
+    #define CW_ENABLE_ALL 1
+#endif
+
+// individual feature flags with defaults based on master switch
+#ifndef CW_ENABLE_COMPILE_TIME_RANDOM
+    #define CW_ENABLE_COMPILE_TIME_RANDOM CW_ENABLE_ALL
+#endif
+
+#ifndef CW_ENABLE_STRING_ENCRYPTION
+    #define CW_ENABLE_STRING_ENCRYPTION CW_ENABLE_ALL
+#endif
+
+#ifndef CW_ENABLE_VALUE_OBFUSCATION
+    #define CW_ENABLE_VALUE_OBFUSCATION CW_ENABLE_ALL
+#endif
+
+#ifndef CW_ENABLE_CONTROL_FLOW
+    #define CW_ENABLE_CONTROL_FLOW CW_ENABLE_ALL
+#endif
+
+#ifndef CW_ENABLE_ANTI_DEBUG
+    #define CW_ENABLE_ANTI_DEBUG CW_ENABLE_ALL
+#endif
+
+#ifndef CW_ENABLE_FUNCTION_OBFUSCATION
+    #define CW_ENABLE_FUNCTION_OBFUSCATION CW_ENABLE_ALL
+#endif
+
+#ifndef CW_ENABLE_DATA_HIDING
+    #define CW_ENABLE_DATA_HIDING CW_ENABLE_ALL
+#endif
+
+#ifndef CW_ENABLE_METAMORPHIC
+    #define CW_ENABLE_METAMORPHIC CW_ENABLE_ALL
+#endif
+
+#ifndef CW_ENABLE_IMPORT_HIDING
+    #define CW_ENABLE_IMPORT_HIDING CW_ENABLE_ALL
+#endif
+
+#ifndef CW_ENABLE_SYSCALLS
+    #define CW_ENABLE_SYSCALLS CW_ENABLE_ALL
+#endif
+
+#ifndef CW_ENABLE_ANTI_VM
+    #define CW_ENABLE_ANTI_VM CW_ENABLE_ALL
+#endif
+
+#ifndef CW_ENABLE_INTEGRITY_CHECKS
+    #define CW_ENABLE_INTEGRITY_CHECKS CW_ENABLE_ALL
+#endif
+
+#ifndef CW_ANTI_DEBUG_RESPONSE
+    #define CW_ANTI_DEBUG_RESPONSE 1  // 0=ignore, 1=crash, 2=fake data
+#endif
+
+// instrumentation only - never on by default
+#ifndef CW_ENABLE_PROFILING
+    #define CW_ENABLE_PROFILING 0
+#endif
+
+// every encrypted-string site enrolls itself for cloakwork::warmup() / cooldown() at
+// static init (one small initializer per site, so off unless asked for)
+#ifndef CW_ENABLE_WARMUP
+    #define CW_ENABLE_WARMUP 0
+#endif
+
+// transient plaintext (CW_STR_STACK, scattered_vector growth, asset chunk readers) goes to
+// locked, undumpable pages from cloakwork/secret_arena.h. it maps and locks memory and pulls
+// the os headers into string.h, so it is off unless asked for
+#ifndef CW_ENABLE_SECRET_ARENA
+    #define CW_ENABLE_SECRET_ARENA 0
+#endif
+
+// size over speed: one decoder body per cipher instead of one per literal
+#ifndef CW_SHARE_INSTANTIATIONS
+    #define CW_SHARE_INSTANTIATIONS 0
+#endif
+
+// validate configuration dependencies
+#if CW_ENABLE_DATA_HIDING && !CW_ENABLE_COMPILE_TIME_RANDOM
+    #error "CW_ENABLE_DATA_HIDING requires CW_ENABLE_COMPILE_TIME_RANDOM to be enabled"
+#endif
+
+#if CW_ENABLE_CONTROL_FLOW && !CW_ENABLE_COMPILE_TIME_RANDOM
+    #error "CW_ENABLE_CONTROL_FLOW requires CW_ENABLE_COMPILE_TIME_RANDOM to be enabled"
+#endif
+
+
+// =================================================================
+// includes
+// =================================================================
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <type_traits>
+#include <utility>
+
+#ifdef _MSC_VER
+    #include <intrin.h>
+#endif
+
+// profiling instrumentation
+#if CW_ENABLE_PROFILING
+    #include <algorithm>
+    #include <cstdio>
+    #include <chrono>
+    #include <mutex>
+    #include <source_location>
+    #include <vector>
+    #if defined(__x86_64__) || defined(__i386__)
+        #include <x86intrin.h>
+    #endif
+#endif
+
+// compiler detection and configuration
+#ifdef _MSC_VER
+    #define CW_FORCEINLINE __forceinline
+    #define CW_NOINLINE __declspec(noinline)
+    #define CW_SECTION(x) __declspec(allocate(x))
+    #define CW_COMPILER_BARRIER() _ReadWriteBarrier()
+    // no inline asm on x64 msvc - fall back to a volatile round trip
+    #define CW_REGISTER_BARRIER(x) ((x) = *static_cast<volatile std::remove_reference_t<decltype(x)>*>(&(x)))
+    #define CW_SEH_TRY __try
+    #define CW_SEH_EXCEPT __except (EXCEPTION_EXECUTE_HANDLER)
+    #define CW_DEBUGBREAK() __debugbreak()
+    #pragma warning(push)
+    #pragma warning(disable: 4996 4244 4267)
+#elif defined(__GNUC__) || defined(__clang__)
+    #define CW_FORCEINLINE __attribute__((always_inline)) inline
+    #define CW_NOINLINE __attribute__((noinline))
+    #define CW_SECTION(x) __attribute__((section(x)))
+    #define CW_COMPILER_BARRIER() asm volatile("" ::: "memory")
+    // hides a register value from the optimizer without touching memory
+    // (non-volatile, so loop-invariant uses can still be hoisted)
+    #define CW_REGISTER_BARRIER(x) asm("" : "+r"(x))
+    // no seh outside msvc - the guarded block simply runs
+    #define CW_SEH_TRY if (true)
+    #define CW_SEH_EXCEPT else
+    #define CW_DEBUGBREAK() __builtin_trap()
+#else
+    #define CW_FORCEINLINE inline
+    #define CW_NOINLINE
+    #define CW_SECTION(x)
+    #define CW_COMPILER_BARRIER() std::atomic_signal_fence(std::memory_order_seq_cst)
+    #define CW_REGISTER_BARRIER(x) ((x) = *static_cast<volatile std::remove_reference_t<decltype(x)>*>(&(x)))
+    #define CW_SEH_TRY if (true)
+    #define CW_SEH_EXCEPT else
+    #define CW_DEBUGBREAK() std::abort()
+#endif
+
+// every header wraps its body in these so msvc noise from the obfuscation patterns stays local
+#ifdef _MSC_VER
+    #define CW_PUSH_WARNINGS __pragma(warning(push)) __pragma(warning(disable: 4996 4244 4267))
+    #define CW_POP_WARNINGS __pragma(warning(pop))
+#else
+    #define CW_PUSH_WARNINGS
+    #define CW_POP_WARNINGS
+#endif
+
+CW_PUSH_WARNINGS
+
+namespace cloakwork {
+
+    // =================================================================
+    // compile-time random number generation
+    // =================================================================
+
+#if CW_ENABLE_COMPILE_TIME_RANDOM
+    namespace detail {
+        template<size_t N>
+        consteval uint32_t fnv1a_hash(const char (&str)[N], uint32_t basis = 0x811c9dc5) {
+            uint32_t hash = basis;
+            for(size_t i = 0; i < N-1; ++i) {
+                hash ^= static_cast<uint32_t>(str[i]);
+                hash *= 0x01000193;
+            }
+            return hash;
+        }
+
+        // hardware random number support (intel/amd rdseed)
+        inline bool try_hardware_random(uint64_t& out) {
+#ifdef _WIN32
+#ifdef __RDSEED__
+            if (_rdseed64_step(reinterpret_cast<unsigned long long*>(&out))) {
+                return true;
+            }
+#endif
+#endif
+            return false;
+        }
+
+        // runtime key derivation - combines multiple entropy sources
+        // note: this doesn't provide cryptographic randomness, it just makes
+        // runtime keys unique per execution to frustrate static analysis
+        // runs once per thread - kept out of line so CW_RANDOM_RT sites stay small
+        CW_NOINLINE inline uint64_t runtime_entropy_seed() {
+            uint64_t entropy = 0;
+
+            // try hardware random first
+            if (try_hardware_random(entropy)) {
+                return entropy;
+            }
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+            // rdtsc - cpu cycle counter (changes every execution)
+            entropy ^= __rdtsc();
+#elif defined(__x86_64__) || defined(__i386__)
+            entropy ^= __builtin_ia32_rdtsc();
+#endif
+
+            // stack (per thread), code and heap addresses (aslr randomizes all of them)
+            volatile char stack_var = 0;
+            entropy ^= reinterpret_cast<uintptr_t>(&stack_var);
+            entropy ^= std::rotl(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(&runtime_entropy_seed)), 29);
+
+            void* heap_alloc = std::malloc(16);
+            if (heap_alloc) {
+                entropy ^= std::rotl(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(heap_alloc)), 41);
+                std::free(heap_alloc);
+            }
+
+            // wall clock and process cpu time
+            entropy ^= static_cast<uint64_t>(std::time(nullptr));
+            entropy ^= static_cast<uint64_t>(std::clock()) << 32;
+
+            // mix the entropy thoroughly using knuth's multiplicative hash
+            entropy ^= std::rotl(entropy, 31);
+            entropy *= 0x9e3779b97f4a7c15ULL;
+            entropy ^= entropy >> 27;
+            entropy *= 0x94d049bb133111ebULL;
+            entropy ^= entropy >> 31;
+
+            return entropy;
+        }
+
+        // fast runtime random using xorshift64* (seeded once per thread)
+        inline uint64_t runtime_entropy() {
+            thread_local uint64_t state = runtime_entropy_seed();
+
+            // xorshift64* algorithm - fast and good quality
+            uint64_t x = state;
+            x ^= x >> 12;
+            x ^= x << 25;
+            x ^= x >> 27;
+            state = x;
+            return x * 0x2545F4914F6CDD1DULL;
+        }
+
+        consteval uint32_t compile_seed() {
+            // combine multiple compile-time values for entropy
+            constexpr uint32_t time_hash = fnv1a_hash(__TIME__);
+            constexpr uint32_t date_hash = fnv1a_hash(__DATE__);
+            constexpr uint32_t file_hash = fnv1a_hash(__FILE__);
+            return time_hash ^ (date_hash << 1) ^ (file_hash >> 1) ^ __LINE__;
+        }
+
+        template<uint32_t Seed>
+        struct random_generator {
+            static consteval uint32_t value() {
+                return (Seed * 1664525u + 1013904223u) ^ __COUNTER__;
+            }
+            static consteval uint32_t next() {
+                return random_generator<value()>::value();
+            }
+        };
+    }
+
+    // separate compile-time and runtime random macros
+    #define CW_RANDOM_CT() (cloakwork::detail::random_generator<cloakwork::detail::compile_seed() ^ __COUNTER__>::value())
+    #define CW_RAND_CT(min, max) ((min) + (CW_RANDOM_CT() % ((max) - (min) + 1)))
+    #define CW_RANDOM_CT64() ((static_cast<uint64_t>(CW_RANDOM_CT()) << 32) | static_cast<uint64_t>(CW_RANDOM_CT()))
+
+    #define CW_RANDOM_RT() (cloakwork::detail::runtime_entropy())
+    #define CW_RAND_RT(min, max) ((min) + (CW_RANDOM_RT() % ((max) - (min) + 1)))
+
+    // backward compatibility - defaults to compile-time
+    #define CW_RANDOM() CW_RANDOM_CT()
+    #define CW_RAND(min, max) CW_RAND_CT(min, max)
+#else
+    // fallback when compile-time random is disabled: deterministic per-site constants,
+    // still usable as template arguments and in constant expressions
+    #define CW_RANDOM_CT() (static_cast<uint32_t>((__COUNTER__ + 1u) * 0x9E3779B9u ^ static_cast<uint32_t>(__LINE__)))
+    #define CW_RAND_CT(min, max) ((min) + (CW_RANDOM_CT() % ((max) - (min) + 1)))
+    #define CW_RANDOM_CT64() ((static_cast<uint64_t>(CW_RANDOM_CT()) << 32) | static_cast<uint64_t>(CW_RANDOM_CT()))
+    #define CW_RANDOM_RT() (rand())
+    #define CW_RAND_RT(min, max) ((min) + (rand() % ((max) - (min) + 1)))
+    #define CW_RANDOM() (rand())
+    #define CW_RAND(min, max) ((min) + (rand() % ((max) - (min) + 1)))
+#endif
+
+    // =================================================================
+    // secure wipe
+    // =================================================================
+
+    namespace detail {
+#if defined(__GNUC__) || defined(__clang__)
+        // the asm takes the pointer and clobbers memory, so every store before it must be
+        // assumed observable (the same barrier glibc's explicit_bzero uses)
+        CW_FORCEINLINE void keep_stores(void* p) {
+            asm volatile("" : : "r"(p) : "memory");
+        }
+#else
+        // calls through a volatile pointer cannot be recognized as memset and dropped
+        inline void* (*volatile wipe_memset)(void*, int, size_t) = &std::memset;
+
+        CW_FORCEINLINE void keep_stores(void*) {
+            CW_COMPILER_BARRIER();
+        }
+#endif
+    }
+
+    // explicit_bzero / memset_explicit semantics: zeroes n bytes even when the buffer is
+    // about to go out of scope or be freed, where a plain memset is a dead store the
+    // optimizer may remove. it is still an ordinary vectorized memset (~20 ns per KiB)
+    inline void secure_wipe(void* p, size_t n) noexcept {
+        if (!n) return;
+#if defined(__GNUC__) || defined(__clang__)
+        std::memset(p, 0, n);
+#else
+        detail::wipe_memset(p, 0, n);
+#endif
+        detail::keep_stores(p);
+    }
+
+    // like secure_wipe but leaves noise instead of zeros, so a wiped buffer does not stand
+    // out in a dump. one CW_RANDOM_RT() call seeds four 64-bit weyl lanes that are stored
+    // as 32-byte words, instead of one rng call per byte
+    inline void secure_scramble(void* p, size_t n) noexcept {
+        if (!n) return;
+        uint64_t seed = static_cast<uint64_t>(CW_RANDOM_RT());
+        uint64_t lane[4];
+        for (auto& l : lane) {
+            seed += 0x9e3779b97f4a7c15ULL;
+            uint64_t z = (seed ^ (seed >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            l = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        }
+
+        // the lanes stay in registers and are stored word by word; a 32-byte copy out of
+        // a just-written array would stall on store forwarding every block
+        uint64_t l0 = lane[0], l1 = lane[1], l2 = lane[2], l3 = lane[3];
+        uint8_t* bytes = static_cast<uint8_t*>(p);
+        size_t i = 0;
+        for (; i + sizeof(lane) <= n; i += sizeof(lane)) {
+            std::memcpy(bytes + i, &l0, 8);
+            std::memcpy(bytes + i + 8, &l1, 8);
+            std::memcpy(bytes + i + 16, &l2, 8);
+            std::memcpy(bytes + i + 24, &l3, 8);
+            l0 += 0x9e3779b97f4a7c15ULL;
+            l1 += 0xc2b2ae3d27d4eb4fULL;
+            l2 += 0x165667b19e3779f9ULL;
+            l3 += 0xd6e8feb86659fd93ULL;
+        }
+        lane[0] = l0; lane[1] = l1; lane[2] = l2; lane[3] = l3;
+        if (i < n) std::memcpy(bytes + i, lane, n - i);
+        detail::keep_stores(p);
+    }
+
+    // =================================================================
+    // protection cost profiling
+    // =================================================================
+
+#if CW_ENABLE_PROFILING
+    // per call site telemetry for the protection macros.
+    // every instrumented site owns a static site_info; each thread accumulates into its own
+    // buffer (single writer, relaxed atomics - no locks on the hot path) and the totals are
+    // written to $CW_PROFILE_OUT (default cloakwork_profile.json, .csv selects csv) at exit.
+    // timestamps are tsc cycles on x86 and steady_clock nanoseconds elsewhere
+    namespace profiling {
+        CW_FORCEINLINE uint64_t timestamp() {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+            return __rdtsc();
+#elif defined(__x86_64__) || defined(__i386__)
+            return __rdtsc();
+#else
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+        }
+
+        inline const char* timestamp_unit() {
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+            return "cycles";
+#else
+            return "ns";
+#endif
+        }
+
+        struct site_info {
+            const char* kind;
+            const char* file;
+            uint32_t line;
+            uint32_t id;
+
+            site_info(const char* k, std::source_location loc);
+        };
+
+        struct totals {
+            uint64_t calls = 0;
+            uint64_t total = 0;
+            uint64_t first = 0;     // duration of the first call (max across threads)
+
+            void merge(uint64_t c, uint64_t t, uint64_t f) {
+                calls += c;
+                total += t;
+                first = std::max(first, f);
+            }
+        };
+
+        class thread_buffer;
+
+        class registry {
+        public:
+            static registry& instance() {
+                static registry reg;
+                return reg;
+            }
+
+            uint32_t add_site(const site_info* site) {
+                std::lock_guard<std::mutex> lock(mtx);
+                sites.push_back(site);
+                retired.emplace_back();
+                return static_cast<uint32_t>(sites.size() - 1);
+            }
+
+            void attach(thread_buffer* buffer) {
+                std::lock_guard<std::mutex> lock(mtx);
+                live.push_back(buffer);
+            }
+
+            void detach(thread_buffer* buffer);
+
+            std::vector<totals> snapshot();
+
+            // format: "json" or "csv"
+            void dump(std::FILE* out, const char* format);
+
+            bool dump(const char* path) {
+                std::FILE* out = std::fopen(path, "w");
+                if (!out) return false;
+                size_t len = std::strlen(path);
+                dump(out, len >= 4 && std::strcmp(path + len - 4, ".csv") == 0 ? "csv" : "json");
+                std::fclose(out);
+                return true;
+            }
+
+            static bool& shut_down() {
+                static bool flag = false;
+                return flag;
+            }
+
+        private:
+            std::mutex mtx;
+            std::vector<const site_info*> sites;
+            std::vector<thread_buffer*> live;
+            std::vector<totals> retired;     // buffers of threads that already exited
+
+            registry() = default;
+
+            // caller holds mtx
+            std::vector<totals> snapshot_locked() const;
+
+            ~registry() {
+                const char* path = std::getenv("CW_PROFILE_OUT");
+                dump(path && *path ? path : "cloakwork_profile.json");
+                shut_down() = true;
+            }
+        };
+
+        class thread_buffer {
+        public:
+            static constexpr size_t PAGE = 256;
+            static constexpr size_t PAGES = 64;
+
+            struct record {
+                std::atomic<uint64_t> calls{0};
+                std::atomic<uint64_t> total{0};
+                std::atomic<uint64_t> first{0};
+            };
+
+            thread_buffer() {
+                registry::instance().attach(this);
+            }
+
+            ~thread_buffer() {
+                if (!registry::shut_down()) registry::instance().detach(this);
+                for (auto& page : pages) delete[] page.load(std::memory_order_relaxed);
+            }
+
+            // only ever called by the owning thread. sites past the table are counted by dump()
+            CW_FORCEINLINE void add(uint32_t id, uint64_t elapsed) {
+                if (id >= PAGE * PAGES) return;
+                record* page = pages[id / PAGE].load(std::memory_order_relaxed);
+                if (!page) {
+                    page = new record[PAGE];
+                    pages[id / PAGE].store(page, std::memory_order_release);
+                }
+
+                record& r = page[id % PAGE];
+                uint64_t calls = r.calls.load(std::memory_order_relaxed);
+                if (calls == 0) r.first.store(elapsed, std::memory_order_relaxed);
+                r.total.store(r.total.load(std::memory_order_relaxed) + elapsed, std::memory_order_relaxed);
+                r.calls.store(calls + 1, std::memory_order_relaxed);
+            }
+
+            // safe from any thread while the owner keeps writing
+            void collect(std::vector<totals>& out) const {
+                for (size_t p = 0; p < PAGES; ++p) {
+                    const record* page = pages[p].load(std::memory_order_acquire);
+                    if (!page) continue;
+                    for (size_t i = 0; i < PAGE && p * PAGE + i < out.size(); ++i) {
+                        out[p * PAGE + i].merge(page[i].calls.load(std::memory_order_relaxed),
+                                                page[i].total.load(std::memory_order_relaxed),
+                                                page[i].first.load(std::memory_order_relaxed));
+                    }
+                }
+            }
+
+        private:
+            std::atomic<record*> pages[PAGES] = {};
+        };
+
+        inline void registry::detach(thread_buffer* buffer) {
+            std::lock_guard<std::mutex> lock(mtx);
+            buffer->collect(retired);
+            live.erase(std::remove(live.begin(), live.end(), buffer), live.end());
+        }
+
+        inline std::vector<totals> registry::snapshot_locked() const {
+            std::vector<totals> out = retired;
+            for (const thread_buffer* buffer : live) buffer->collect(out);
+            return out;
+        }
+
+        inline std::vector<totals> registry::snapshot() {
+            std::lock_guard<std::mutex> lock(mtx);
+            return snapshot_locked();
+        }
+
+        inline void registry::dump(std::FILE* out, const char* format) {
+            // one lock for the totals and the site list, so a site added meanwhile can't
+            // leave sites longer than data
+            std::lock_guard<std::mutex> lock(mtx);
+            std::vector<totals> data = snapshot_locked();
+            bool csv = std::strcmp(format, "csv") == 0;
+
+            // thread buffers only have room for the first PAGE * PAGES sites; calls of any
+            // later site are not recorded, and the dump says how many sites that was
+            constexpr size_t capacity = thread_buffer::PAGE * thread_buffer::PAGES;
+            unsigned long long dropped = sites.size() > capacity ? sites.size() - capacity : 0;
+
+            auto put_escaped = [out](const char* str) {
+                for (; *str; ++str) {
+                    if (*str == '"' || *str == '\\') std::fputc('\\', out);
+                    std::fputc(*str, out);
+                }
+            };
+
+            if (csv) {
+                std::fprintf(out, "kind,file,line,calls,total_%s,mean_%s,first_%s\n", timestamp_unit(), timestamp_unit(), timestamp_unit());
+            } else {
+                std::fprintf(out, "{\n  \"unit\": \"%s\",\n  \"dropped_sites\": %llu,\n  \"sites\": [", timestamp_unit(), dropped);
+            }
+
+            bool first_row = true;
+            for (size_t i = 0; i < sites.size(); ++i) {
+                const totals& t = data[i];
+                if (!t.calls) continue;
+                unsigned long long mean = t.total / t.calls;
+
+                if (csv) {
+                    std::fprintf(out, "%s,\"", sites[i]->kind);
+                    put_escaped(sites[i]->file);
+                    std::fprintf(out, "\",%u,%llu,%llu,%llu,%llu\n", sites[i]->line,
+                                 static_cast<unsigned long long>(t.calls), static_cast<unsigned long long>(t.total),
+                                 mean, static_cast<unsigned long long>(t.first));
+                } else {
+                    std::fprintf(out, "%s\n    {\"kind\": \"%s\", \"file\": \"", first_row ? "" : ",", sites[i]->kind);
+                    put_escaped(sites[i]->file);
+                    std::fprintf(out, "\", \"line\": %u, \"calls\": %llu, \"total\": %llu, \"mean\": %llu, \"first\": %llu}",
+                                 sites[i]->line, static_cast<unsigned long long>(t.calls),
+                                 static_cast<unsigned long long>(t.total), mean, static_cast<unsigned long long>(t.first));
+                }
+                first_row = false;
+            }
+
+            if (!csv) {
+                std::fprintf(out, "\n  ]\n}\n");
+            } else if (dropped) {
+                std::fprintf(out, "# dropped_sites,%llu\n", dropped);
+            }
+        }
+
+        inline site_info::site_info(const char* k, std::source_location loc)
+            : kind(k), file(loc.file_name()), line(loc.line()), id(registry::instance().add_site(this)) {}
+
+        inline thread_buffer& local_buffer() {
+            thread_local thread_buffer buffer;
+            return buffer;
+        }
+
+        // times its own lifetime and books it to a site
+        class probe {
+        public:
+            explicit probe(const site_info& s) : site(s), start(timestamp()) {}
+            ~probe() { local_buffer().add(site.id, timestamp() - start); }
+            probe(const probe&) = delete;
+            probe& operator=(const probe&) = delete;
+
+        private:
+            const site_info& site;
+            uint64_t start;
+        };
+
+        // writes the current totals without waiting for exit
+        inline bool dump(const char* path) { return registry::instance().dump(path); }
+    }
+
+    #define CW_PROFILE_SITE(kind) ([]() -> const cloakwork::profiling::site_info& { \
+        static const cloakwork::profiling::site_info cw_site{kind, std::source_location::current()}; \
+        return cw_site; }())
+
+    // times the rest of the enclosing scope
+    #define CW_PROFILE_PROBE(kind) cloakwork::profiling::probe cw_profile_probe{CW_PROFILE_SITE(kind)}
+
+    // times the enclosing full expression (usable at namespace scope)
+    #define CW_PROFILE_WRAP(kind, ...) (cloakwork::profiling::probe{CW_PROFILE_SITE(kind)}, __VA_ARGS__)
+#else
+    #define CW_PROFILE_PROBE(kind) ((void)0)
+    #define CW_PROFILE_WRAP(kind, ...) (__VA_ARGS__)
+#endif
+
+    // =================================================================
+    // warmup registry
+    // =================================================================
+
+    // encrypted objects walked by cloakwork::warmup() / cooldown() (cloakwork/registry.h).
+    // tasks are intrusive nodes pushed lock-free, so enrolling is safe during static init.
+    // with CW_ENABLE_WARMUP every CW_STR-family site enrolls itself before main; anything
+    // else (assets, custom caches) can enroll its own task
+    namespace registry {
+        struct warm_task {
+            void (*run)(void* context, bool warm);  // warm: decrypt / prefetch, otherwise re-encrypt
+            void* context;
+            warm_task* next;
+        };
+
+        inline constinit std::atomic<warm_task*> warm_tasks{nullptr};
+
+        // the task must stay alive until exit; tasks are never removed
+        inline void enroll(warm_task& task) {
+            warm_task* head = warm_tasks.load(std::memory_order_relaxed);
+            do {
+                task.next = head;
+            } while (!warm_tasks.compare_exchange_weak(head, &task, std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        // objects holding plaintext, for cloakwork::reencrypt_all(). an object lists its node on
+        // its first decrypt and unlists it in its destructor. listing is a lock-free push;
+        // unlisting and walking the list take a spin lock, since both are rare
+        struct live_node {
+            void (*reseal)(const void* owner) = nullptr;
+            const void* owner = nullptr;
+            live_node* next = nullptr;
+            std::atomic<bool> listed{false};
+        };
+
+        inline constinit std::atomic<live_node*> live_objects{nullptr};
+        inline constinit std::atomic<bool> live_lock{false};
+
+        // bumped by every decrypt; the idle policy reseals once it stops moving
+        inline constinit std::atomic<uint64_t> decrypt_epoch{0};
+
+        class live_guard {
+        public:
+            live_guard() {
+                while (live_lock.exchange(true, std::memory_order_acquire)) live_lock.wait(true, std::memory_order_relaxed);
+            }
+            ~live_guard() {
+                live_lock.store(false, std::memory_order_release);
+                live_lock.notify_one();
+            }
+            live_guard(const live_guard&) = delete;
+            live_guard& operator=(const live_guard&) = delete;
+        };
+
+        // called on the decrypt slow path of every encrypted object; lists it the first time
+        CW_NOINLINE inline void note_decrypt(live_node& node, const void* owner, void (*reseal)(const void*)) {
+            decrypt_epoch.fetch_add(1, std::memory_order_relaxed);
+            if (node.listed.load(std::memory_order_relaxed) || node.listed.exchange(true, std::memory_order_acq_rel)) return;
+            node.owner = owner;
+            node.reseal = reseal;
+            live_node* head = live_objects.load(std::memory_order_relaxed);
+            do {
+                node.next = head;
+            } while (!live_objects.compare_exchange_weak(head, &node, std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        // statics are destroyed in reverse order of first use, which is list order, so the
+        // node is almost always the head
+        inline void unlist(live_node& node) {
+            if (!node.listed.load(std::memory_order_acquire)) return;
+            live_guard guard;
+            live_node* head = &node;
+            if (live_objects.compare_exchange_strong(head, node.next, std::memory_order_acq_rel)) return;
+            for (live_node* p = live_objects.load(std::memory_order_acquire); p; p = p->next) {
+                if (p->next == &node) {
+                    p->next = node.next;
+                    return;
+                }
+            }
+        }
+
+        // one instantiation per CW_WARMUP_SITE. naming `enrolled` instantiates it, and its
+        // initializer enrolls the task before main
+        template<typename Site>
+        struct warm_site {
+            static void run(void*, bool warm) { Site::run(warm); }
+            static inline warm_task task{ &run, nullptr, nullptr };
+            static inline const bool enrolled = (enroll(task), true);
+        };
+    }
+
+#if CW_ENABLE_WARMUP
+    // `object` is the site's constant-initialized static (get() / reencrypt())
+    #define CW_WARMUP_SITE(object) \
+        struct cw_warmup_site { \
+            static void run(bool warm) { if (warm) (void)object.get(); else object.reencrypt(); } \
+        }; \
+        (void)cloakwork::registry::warm_site<cw_warmup_site>::enrolled
+#else
+    #define CW_WARMUP_SITE(object) ((void)0)
+#endif
+
+    // =================================================================
+    // per-site protection levels
+    // =================================================================
+
+    // level tags, cheapest first. the _P macros take a level value (cw::hot),
+    // templates take the type (cw::level::hot)
+    namespace level {
+        struct hot {};          // no periodic checks, no mba, no access jitter
+        struct light {};        // mba encoding, still no periodic checks
+        struct standard {};     // the behaviour of the plain macros
+        struct strong {};       // denser checks, fresh keys on every write, layered strings
+    }
+
+    inline constexpr level::hot hot{};
+    inline constexpr level::light light{};
+    inline constexpr level::standard standard{};
+    inline constexpr level::strong strong{};
+
+    // knobs each primitive reads for its level. specialize for your own level tags
+    template<typename Level>
+    struct level_traits;
+
+    template<>
+    struct level_traits<level::hot> {
+        static constexpr uint32_t value_check_period = 0;   // 0 = never
+        static constexpr uint32_t call_check_period = 0;
+        static constexpr bool value_mba = false;
+        static constexpr bool rekey_on_write = false;
+        static constexpr bool string_jitter = false;
+        static constexpr bool string_layered = false;
+    };
+
+    template<>
+    struct level_traits<level::light> {
+        static constexpr uint32_t value_check_period = 0;
+        static constexpr uint32_t call_check_period = 0;
+        static constexpr bool value_mba = true;
+        static constexpr bool rekey_on_write = false;
+        static constexpr bool string_jitter = false;
+        static constexpr bool string_layered = false;
+    };
+
+    template<>
+    struct level_traits<level::standard> {
+        static constexpr uint32_t value_check_period = 1000;
+        static constexpr uint32_t call_check_period = 100;
+        static constexpr bool value_mba = true;
+        static constexpr bool rekey_on_write = false;
+        static constexpr bool string_jitter = true;
+        static constexpr bool string_layered = false;
+    };
+
+    template<>
+    struct level_traits<level::strong> {
+        static constexpr uint32_t value_check_period = 100;
+        static constexpr uint32_t call_check_period = 16;
+        static constexpr bool value_mba = true;
+        static constexpr bool rekey_on_write = true;
+        static constexpr bool string_jitter = true;
+        static constexpr bool string_layered = true;
+    };
+
+    #define CW_LEVEL_TYPE(lvl) std::remove_cvref_t<decltype(lvl)>
+
+    // per-translation-unit default used by the plain macros (CW_STR, CW_INT, CW_CALL).
+    // define before including, e.g. #define CW_DEFAULT_LEVEL cloakwork::light
+    #ifndef CW_DEFAULT_LEVEL
+        #define CW_DEFAULT_LEVEL cloakwork::standard
+    #endif
+
+    // concepts for type constraints (also used by data hiding)
+    template<typename T>
+    concept Integral = std::is_integral_v<T>;
+
+    template<typename T>
+    concept Arithmetic = std::is_arithmetic_v<T>;
+
+} // namespace cloakwork
+
+// short alias for level tags: cw::hot, cw::level::light. define CW_NO_NAMESPACE_ALIAS to opt out
+#ifndef CW_NO_NAMESPACE_ALIAS
+namespace cw = cloakwork;
+#endif
+
+CW_POP_WARNINGS
+
+#endif // CLOAKWORK_CORE_H
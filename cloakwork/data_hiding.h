@@ -0,0 +1,942 @@
+#ifndef CLOAKWORK_DATA_HIDING_H
+#define CLOAKWORK_DATA_HIDING_H
+
+// cloakwork/data_hiding.h - scattered and polymorphic values, scattered containers (CW_SCATTER, CW_POLY)
+
+#include "core.h"
+
+#if CW_ENABLE_SECRET_ARENA
+    #include "secret_arena.h"
+#endif
+
+#include <algorithm>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+CW_PUSH_WARNINGS
+
+namespace cloakwork {
+
+    // =================================================================
+    // advanced data hiding techniques
+    // =================================================================
+
+#if CW_ENABLE_DATA_HIDING
+    namespace data_hiding {
+
+        // slab pool backing scattered chunks
+        // chunks are carved from 64kb slabs in power-of-two slot classes. slots are picked at
+        // random (one of the first few slabs with a free slot, random starting slot) so the
+        // chunks of one value are still spread across memory, but constructing a scattered
+        // value costs a bitmap search instead of a malloc per chunk. slabs are aligned to
+        // their size and keep their bitmap in a header at the front, so a freed slot finds its
+        // slab by masking its address; each class lists its slabs that have a free slot, and
+        // a summary bitmap points at the non-full bitmap words. allocating and freeing cost
+        // the same with a million values live as with none. the batch overloads take the lock
+        // once for all the chunks of a value.
+        // freed slots are wiped and reused; a class keeps one empty slab and hands any other
+        // slab that empties back to the heap.
+        class scatter_arena {
+        private:
+            static constexpr size_t SLAB_BYTES = 64 * 1024;
+            static constexpr size_t MIN_SLOT = 8;
+            static constexpr size_t CLASS_COUNT = 6;  // 8, 16, 32, 64, 128, 256 bytes
+            static constexpr size_t MAX_WORDS = SLAB_BYTES / MIN_SLOT / 64;
+            static constexpr size_t SUMMARY_WORDS = (MAX_WORDS + 63) / 64;
+            static constexpr size_t SPREAD_SLABS = 4;   // candidates per slot; bounds the cache / tlb footprint
+            static constexpr uint32_t NOT_LISTED = ~uint32_t(0);
+
+            // occupies the first slots of its slab, which are marked used
+            struct slab_header {
+                std::array<uint64_t, MAX_WORDS> used;         // one bit per slot
+                std::array<uint64_t, SUMMARY_WORDS> open;     // one bit per bitmap word with a free slot
+                uint32_t words;
+                uint32_t capacity;      // usable slots
+                uint32_t free_slots;
+                uint32_t list_index;    // position in the class's open list, or NOT_LISTED
+                uint32_t slab_index;    // position in slabs
+                uint32_t cls;
+            };
+
+            std::array<std::vector<slab_header*>, CLASS_COUNT> open_slabs;
+            std::array<size_t, CLASS_COUNT> empty_slabs{};
+            std::vector<slab_header*> slabs;
+            std::mutex mutex;
+
+            static constexpr size_t class_index(size_t size) {
+                size_t cls = 0;
+                size_t slot = MIN_SLOT;
+                while (slot < size) {
+                    slot <<= 1;
+                    ++cls;
+                }
+                return cls;
+            }
+
+            static constexpr size_t slot_size(size_t cls) {
+                return MIN_SLOT << cls;
+            }
+
+            // uniform in [0, n) for n < 2^32 without a division
+            static CW_FORCEINLINE size_t below(uint64_t random, size_t n) {
+                return static_cast<size_t>(((random >> 32) * n) >> 32);
+            }
+
+            static CW_FORCEINLINE slab_header* slab_of(const uint8_t* ptr) {
+                return reinterpret_cast<slab_header*>(reinterpret_cast<uintptr_t>(ptr) & ~uintptr_t(SLAB_BYTES - 1));
+            }
+
+            void list_open(slab_header* h) {
+                h->list_index = static_cast<uint32_t>(open_slabs[h->cls].size());
+                open_slabs[h->cls].push_back(h);
+            }
+
+            void unlist_open(slab_header* h) {
+                auto& list = open_slabs[h->cls];
+                slab_header* last = list.back();
+                list[h->list_index] = last;
+                last->list_index = h->list_index;
+                list.pop_back();
+                h->list_index = NOT_LISTED;
+            }
+
+            void add_slab(size_t cls) {
+                const size_t slots = SLAB_BYTES / slot_size(cls);
+                const size_t reserved = (sizeof(slab_header) + slot_size(cls) - 1) / slot_size(cls);
+
+                // reserve first so nothing can throw once the slab exists
+                open_slabs[cls].reserve(open_slabs[cls].size() + 1);
+                slabs.reserve(slabs.size() + 1);
+
+                void* memory = ::operator new(SLAB_BYTES, std::align_val_t(SLAB_BYTES));
+                std::memset(memory, 0, SLAB_BYTES);
+                slab_header* h = new (memory) slab_header{};
+                h->words = static_cast<uint32_t>(slots / 64);
+                h->capacity = static_cast<uint32_t>(slots - reserved);
+                h->free_slots = h->capacity;
+                h->slab_index = static_cast<uint32_t>(slabs.size());
+                h->cls = static_cast<uint32_t>(cls);
+                for (size_t slot = 0; slot < reserved; ++slot) h->used[slot / 64] |= 1ULL << (slot % 64);
+                for (size_t w = 0; w < h->words; ++w) {
+                    if (~h->used[w]) h->open[w / 64] |= 1ULL << (w % 64);
+                }
+
+                list_open(h);
+                slabs.push_back(h);
+                ++empty_slabs[cls];
+            }
+
+            // an empty slab beyond the class's spare; its slots were wiped when they were freed
+            void free_slab(slab_header* h) {
+                unlist_open(h);
+                slab_header* last = slabs.back();
+                slabs[h->slab_index] = last;
+                last->slab_index = h->slab_index;
+                slabs.pop_back();
+                secure_wipe(h, sizeof(slab_header));
+                ::operator delete(static_cast<void*>(h), std::align_val_t(SLAB_BYTES));
+            }
+
+            // first non-full bitmap word at or after `start`, wrapping around
+            static size_t open_word(const slab_header& h, size_t start) {
+                const size_t count = (h.words + 63) / 64;
+                size_t s = start / 64;
+                uint64_t bits = h.open[s] & (~0ULL << (start % 64));
+                for (size_t n = 0; n <= count; ++n) {
+                    if (bits) return s * 64 + static_cast<size_t>(std::countr_zero(bits));
+                    s = s + 1 == count ? 0 : s + 1;
+                    bits = h.open[s];
+                }
+                return 0;  // unreachable: listed slabs have a free slot
+            }
+
+            uint8_t* take_slot(size_t cls) {
+                if (open_slabs[cls].empty()) add_slab(cls);
+                const auto& list = open_slabs[cls];
+                const uint64_t random = CW_RANDOM_RT();
+                slab_header* h = list[below(random, std::min(list.size(), SPREAD_SLABS))];
+                if (h->free_slots == h->capacity) --empty_slabs[cls];
+
+                // a random starting slot; the rotation keeps the lowest free bit of a
+                // word from always being chosen first
+                const size_t start = below(random << 32, size_t(h->words) * 64);
+                const size_t w = open_word(*h, start / 64);
+                const int rot = static_cast<int>(start & 63);
+                const uint64_t free_bits = ~h->used[w];
+                const size_t bit = (static_cast<size_t>(std::countr_zero(std::rotr(free_bits, rot))) + rot) & 63;
+
+                h->used[w] |= 1ULL << bit;
+                if (!~h->used[w]) h->open[w / 64] &= ~(1ULL << (w % 64));
+                if (--h->free_slots == 0) unlist_open(h);
+                return reinterpret_cast<uint8_t*>(h) + (w * 64 + bit) * slot_size(cls);
+            }
+
+            void release_slot(uint8_t* ptr) {
+                slab_header* h = slab_of(ptr);
+                const size_t slot = static_cast<size_t>(ptr - reinterpret_cast<uint8_t*>(h)) / slot_size(h->cls);
+                const size_t w = slot / 64;
+                h->used[w] &= ~(1ULL << (slot % 64));
+                h->open[w / 64] |= 1ULL << (w % 64);
+                if (h->free_slots++ == 0) list_open(h);
+                if (h->free_slots == h->capacity) {
+                    if (empty_slabs[h->cls]) free_slab(h);
+                    else ++empty_slabs[h->cls];
+                }
+            }
+
+        public:
+            static constexpr size_t MAX_SLOT = MIN_SLOT << (CLASS_COUNT - 1);
+
+            static scatter_arena& instance() {
+                static scatter_arena arena;
+                return arena;
+            }
+
+            scatter_arena() = default;
+            scatter_arena(const scatter_arena&) = delete;
+            scatter_arena& operator=(const scatter_arena&) = delete;
+
+            ~scatter_arena() {
+                for (slab_header* h : slabs) {
+                    secure_wipe(h, SLAB_BYTES);
+                    ::operator delete(static_cast<void*>(h), std::align_val_t(SLAB_BYTES));
+                }
+            }
+
+            // out[i] gets a slot of at least sizes[i] bytes (nullptr for 0), all under one lock.
+            // throws std::bad_alloc with nothing taken
+            void allocate(const size_t* sizes, uint8_t** out, size_t count) {
+                std::lock_guard<std::mutex> lock(mutex);
+                size_t i = 0;
+                try {
+                    for (; i < count; ++i) {
+                        if (sizes[i] == 0) out[i] = nullptr;
+                        else if (sizes[i] > MAX_SLOT) out[i] = new uint8_t[sizes[i]];
+                        else out[i] = take_slot(class_index(sizes[i]));
+                    }
+                } catch (...) {
+                    while (i--) {
+                        if (sizes[i] > MAX_SLOT) delete[] out[i];
+                        else if (out[i]) release_slot(out[i]);
+                    }
+                    throw;
+                }
+            }
+
+            // wipes and returns slots from allocate(); sizes are the requested ones
+            void deallocate(uint8_t* const* ptrs, const size_t* sizes, size_t count) {
+                size_t slotted = 0;
+                for (size_t i = 0; i < count; ++i) {
+                    if (!ptrs[i]) continue;
+                    if (sizes[i] > MAX_SLOT) {
+                        secure_wipe(ptrs[i], sizes[i]);
+                        delete[] ptrs[i];
+                    } else {
+                        secure_wipe(ptrs[i], slot_size(class_index(sizes[i])));
+                        ++slotted;
+                    }
+                }
+                if (!slotted) return;
+
+                std::lock_guard<std::mutex> lock(mutex);
+                for (size_t i = 0; i < count; ++i) {
+                    if (ptrs[i] && sizes[i] <= MAX_SLOT) release_slot(ptrs[i]);
+                }
+            }
+
+            uint8_t* allocate(size_t size) {
+                uint8_t* ptr;
+                allocate(&size, &ptr, 1);
+                return ptr;
+            }
+
+            void deallocate(uint8_t* ptr, size_t size) {
+                deallocate(&ptr, &size, 1);
+            }
+        };
+
+        // sequence lock shared by the data hiding types
+        // readers never block writers and never write shared state; they retry if a
+        // write overlapped. protected bytes must be accessed through relaxed_load /
+        // relaxed_store so the overlapping accesses are not data races.
+        class seqlock {
+        private:
+            std::atomic<uint32_t> sequence{0};
+
+        public:
+            CW_FORCEINLINE uint32_t read_begin() const {
+                uint32_t seq = sequence.load(std::memory_order_acquire);
+                while (seq & 1) {
+                    seq = sequence.load(std::memory_order_acquire);
+                }
+                return seq;
+            }
+
+            CW_FORCEINLINE bool read_retry(uint32_t seq) const {
+                std::atomic_thread_fence(std::memory_order_acquire);
+                return sequence.load(std::memory_order_relaxed) != seq;
+            }
+
+            CW_FORCEINLINE bool try_write_lock() {
+                uint32_t seq = sequence.load(std::memory_order_relaxed);
+                if (seq & 1) return false;
+                if (!sequence.compare_exchange_strong(seq, seq + 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+                    return false;
+                }
+                std::atomic_thread_fence(std::memory_order_release);
+                return true;
+            }
+
+            CW_FORCEINLINE void write_lock() {
+                while (!try_write_lock()) {}
+            }
+
+            CW_FORCEINLINE void write_unlock() {
+                sequence.fetch_add(1, std::memory_order_release);
+            }
+        };
+
+        template<typename U>
+        CW_FORCEINLINE U relaxed_load(const U& src) {
+            return std::atomic_ref<U>(const_cast<U&>(src)).load(std::memory_order_relaxed);
+        }
+
+        template<typename U>
+        CW_FORCEINLINE void relaxed_store(U& dst, U value) {
+            std::atomic_ref<U>(dst).store(value, std::memory_order_relaxed);
+        }
+
+        // actually scatter data across separate memory slots (not just logical)
+        // get() is a lock-free seqlock read, set() is serialized against other writers.
+        // moves hand the slots over without re-scattering; copies scatter into fresh slots.
+        // a moved-from value reads as T{} and may be destroyed or written again: its next
+        // set() or assignment takes fresh slots, so (like the move itself) that first write
+        // must not race with readers of the moved-from object.
+        template<typename T, size_t Chunks = 8>
+        class scattered_value {
+        private:
+            static_assert(Chunks > 1 && Chunks <= 64, "Chunks must be between 2 and 64");
+            static_assert(sizeof(T) >= Chunks || Chunks == 2, "Too many chunks for type size");
+
+            // one arena slot; the value owns all of them and releases them together
+            struct chunk {
+                uint8_t* data;
+                uint32_t size;
+                uint8_t xor_key;
+            };
+
+            static constexpr std::array<size_t, Chunks> chunk_sizes = [] {
+                std::array<size_t, Chunks> sizes{};
+                for (size_t i = 0; i < Chunks; ++i) sizes[i] = sizeof(T) / Chunks + (i < sizeof(T) % Chunks ? 1 : 0);
+                return sizes;
+            }();
+
+            std::array<chunk, Chunks> chunks{};
+            mutable seqlock lock;
+
+            // slots are taken once per object (in one arena call); set() only rewrites them
+            void allocate_chunks() {
+                std::array<uint8_t*, Chunks> slots;
+                scatter_arena::instance().allocate(chunk_sizes.data(), slots.data(), Chunks);
+                for (size_t i = 0; i < Chunks; ++i) {
+                    chunks[i].data = slots[i];
+                    chunks[i].size = static_cast<uint32_t>(chunk_sizes[i]);
+                }
+            }
+
+            void release_chunks() {
+                if (!chunks[0].data) return;
+                std::array<uint8_t*, Chunks> slots;
+                for (size_t i = 0; i < Chunks; ++i) slots[i] = chunks[i].data;
+                scatter_arena::instance().deallocate(slots.data(), chunk_sizes.data(), Chunks);
+                chunks = {};
+            }
+
+            void scatter_data(const T& value) {
+                // chunk 0 always holds at least one byte, so no slot means moved from
+                if (!chunks[0].data) allocate_chunks();
+
+                const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+                size_t byte_idx = 0;
+                uint64_t keys = 0;
+
+                lock.write_lock();
+                for(size_t i = 0; i < Chunks; ++i) {
+                    // fresh key on every write, rewritten in place; one random draw keys 8 chunks
+                    if (i % 8 == 0) keys = CW_RANDOM_RT();
+                    uint8_t key = static_cast<uint8_t>(keys >> (i % 8 * 8));
+                    relaxed_store(chunks[i].xor_key, key);
+
+                    for(size_t j = 0; j < chunks[i].size && byte_idx < sizeof(T); ++j, ++byte_idx) {
+                        relaxed_store(chunks[i].data[j], static_cast<uint8_t>(bytes[byte_idx] ^ key));
+                    }
+                }
+                lock.write_unlock();
+            }
+
+        public:
+            scattered_value() {
+                T default_value{};
+                allocate_chunks();
+                scatter_data(default_value);
+            }
+
+            scattered_value(const T& value) {
+                allocate_chunks();
+                scatter_data(value);
+            }
+
+            scattered_value(const scattered_value& other) {
+                allocate_chunks();
+                scatter_data(other.get());
+            }
+
+            scattered_value(scattered_value&& other) noexcept
+                : chunks(std::exchange(other.chunks, {})) {}
+
+            scattered_value& operator=(const scattered_value& other) {
+                if (this != &other) scatter_data(other.get());
+                return *this;
+            }
+
+            scattered_value& operator=(scattered_value&& other) noexcept {
+                if (this != &other) {
+                    release_chunks();
+                    chunks = std::exchange(other.chunks, {});
+                }
+                return *this;
+            }
+
+            ~scattered_value() {
+                release_chunks();
+            }
+
+            CW_FORCEINLINE T get() const {
+                T result{};
+                uint8_t* result_bytes = reinterpret_cast<uint8_t*>(&result);
+                uint32_t seq;
+
+                do {
+                    seq = lock.read_begin();
+                    size_t byte_idx = 0;
+
+                    for(size_t i = 0; i < Chunks; ++i) {
+                        uint8_t key = relaxed_load(chunks[i].xor_key);
+                        for(size_t j = 0; j < chunks[i].size && byte_idx < sizeof(T); ++j, ++byte_idx) {
+                            result_bytes[byte_idx] = relaxed_load(chunks[i].data[j]) ^ key;
+                        }
+                    }
+                } while (lock.read_retry(seq));
+
+                return result;
+            }
+
+            CW_FORCEINLINE operator T() const { return get(); }
+
+            CW_FORCEINLINE void set(const T& value) {
+                scatter_data(value);
+            }
+        };
+
+        // polymorphic value that changes representation
+        // the value is stored xor-encoded and periodically re-keyed in place (the plaintext
+        // is never written back). reads are seqlock snapshots of (encoded, key); a re-key
+        // that loses the race to another writer is simply skipped, so concurrent get()
+        // calls never block each other. the access tick is per-thread to keep the read
+        // path free of shared writes. types wider than 64 bits (long double, __int128) are
+        // held as several 64-bit words, each with its own key.
+        template<Arithmetic T>
+        class polymorphic_value {
+        private:
+            using word_t = std::conditional_t<sizeof(T) == 1, uint8_t,
+                           std::conditional_t<sizeof(T) == 2, uint16_t,
+                           std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>>;
+
+            static constexpr size_t WORDS = (sizeof(T) + sizeof(word_t) - 1) / sizeof(word_t);
+            static constexpr uint32_t MUTATION_PERIOD = 100;
+
+            using bits_t = std::array<word_t, WORDS>;
+
+            mutable bits_t encoded{};
+            mutable bits_t key{};
+            mutable seqlock lock;
+
+            static CW_FORCEINLINE bits_t to_bits(T val) {
+                bits_t bits{};
+                std::memcpy(bits.data(), &val, sizeof(T));
+                return bits;
+            }
+
+            static CW_FORCEINLINE T from_bits(const bits_t& bits) {
+                T val;
+                std::memcpy(&val, bits.data(), sizeof(T));
+                return val;
+            }
+
+            static CW_FORCEINLINE bits_t fresh_key() {
+                bits_t k;
+                for (auto& w : k) w = static_cast<word_t>(CW_RANDOM_RT());
+                return k;
+            }
+
+            CW_FORCEINLINE void mutate() const {
+                thread_local uint32_t access_tick = 0;
+                if(++access_tick % MUTATION_PERIOD != 0) return;
+
+                // another writer is active - its write already changes the representation
+                if(!lock.try_write_lock()) return;
+
+                const bits_t new_key = fresh_key();
+                CW_COMPILER_BARRIER();
+
+                // re-key without decoding: (v ^ old) ^ (old ^ new) == v ^ new
+                for (size_t w = 0; w < WORDS; ++w) {
+                    word_t old_key = relaxed_load(key[w]);
+                    relaxed_store(encoded[w], static_cast<word_t>(relaxed_load(encoded[w]) ^ old_key ^ new_key[w]));
+                    relaxed_store(key[w], new_key[w]);
+                }
+                lock.write_unlock();
+            }
+
+            CW_FORCEINLINE void store(T val) {
+                const bits_t bits = to_bits(val);
+                const bits_t new_key = fresh_key();
+                lock.write_lock();
+                for (size_t w = 0; w < WORDS; ++w) {
+                    relaxed_store(encoded[w], static_cast<word_t>(bits[w] ^ new_key[w]));
+                    relaxed_store(key[w], new_key[w]);
+                }
+                lock.write_unlock();
+            }
+
+            CW_FORCEINLINE T load() const {
+                bits_t bits;
+                uint32_t seq;
+                do {
+                    seq = lock.read_begin();
+                    for (size_t w = 0; w < WORDS; ++w) {
+                        bits[w] = static_cast<word_t>(relaxed_load(encoded[w]) ^ relaxed_load(key[w]));
+                    }
+                } while (lock.read_retry(seq));
+                return from_bits(bits);
+            }
+
+        public:
+            polymorphic_value() { store(T{}); }
+            polymorphic_value(T val) { store(val); }
+
+            // copies and moves re-encode under a fresh key
+            polymorphic_value(const polymorphic_value& other) { store(other.load()); }
+            polymorphic_value& operator=(const polymorphic_value& other) {
+                if (this != &other) store(other.load());
+                return *this;
+            }
+
+            CW_FORCEINLINE T get() const {
+                T result = load();
+                mutate();
+                return result;
+            }
+
+            CW_FORCEINLINE void set(T val) {
+                store(val);
+            }
+
+            CW_FORCEINLINE operator T() const { return get(); }
+        };
+
+        // scattered container for whole tables of trivially copyable elements
+        // element bytes are interleaved across Blocks large allocations: byte j of every
+        // element goes to a randomly chosen (block, lane) pair, and element i lives in row
+        // (i * odd multiplier) mod capacity, so neighbouring elements are not adjacent
+        // either. every block has its own key and the keystream also depends on row and lane.
+        // indexing is O(1) (one gather per element byte) and the layout and keys are rolled
+        // again whenever the storage grows. not synchronized - treat it like std::vector.
+        template<typename T, size_t Blocks = 4>
+        class scattered_vector {
+        private:
+            static_assert(std::is_trivially_copyable_v<T>, "scattered_vector requires a trivially copyable type");
+            static_assert(Blocks >= 2 && Blocks <= 16, "Blocks must be between 2 and 16");
+
+            // bytes of one element held by each block (unused lanes are filled with noise)
+            static constexpr size_t LANES = (sizeof(T) + Blocks - 1) / Blocks;
+
+            std::array<std::unique_ptr<uint8_t[]>, Blocks> blocks;
+            std::array<uint64_t, Blocks> block_keys{};
+            std::array<uint8_t, sizeof(T)> byte_block{};
+            std::array<uint32_t, sizeof(T)> byte_lane{};
+            size_t count = 0;
+            size_t cap = 0;       // always a power of two
+            size_t row_mul = 1;   // odd, so i -> (i * row_mul) & (cap - 1) is a permutation
+
+            CW_FORCEINLINE size_t row_of(size_t i) const {
+                return (i * row_mul) & (cap - 1);
+            }
+
+            static CW_FORCEINLINE uint8_t keystream(uint64_t key, size_t row, size_t lane) {
+                return static_cast<uint8_t>(std::rotr(key, static_cast<int>((lane * 8 + row) & 63))) ^
+                       static_cast<uint8_t>(row * 0x9D);
+            }
+
+            void shuffle_layout() {
+                // fisher-yates over all (block, lane) positions, the first sizeof(T) are used
+                std::array<uint32_t, Blocks * LANES> order;
+                for (size_t k = 0; k < order.size(); ++k) {
+                    order[k] = static_cast<uint32_t>(k);
+                }
+                for (size_t k = order.size() - 1; k > 0; --k) {
+                    std::swap(order[k], order[CW_RANDOM_RT() % (k + 1)]);
+                }
+                for (size_t j = 0; j < sizeof(T); ++j) {
+                    byte_block[j] = static_cast<uint8_t>(order[j] % Blocks);
+                    byte_lane[j] = static_cast<uint32_t>(order[j] / Blocks);
+                }
+                for (auto& key : block_keys) {
+                    key = CW_RANDOM_RT();
+                }
+                row_mul = static_cast<size_t>(CW_RANDOM_RT()) | 1;
+            }
+
+            CW_FORCEINLINE void encode(size_t i, const T& value) {
+                const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+                size_t row = row_of(i);
+                for (size_t j = 0; j < sizeof(T); ++j) {
+                    size_t b = byte_block[j];
+                    size_t lane = byte_lane[j];
+                    blocks[b][row * LANES + lane] = bytes[j] ^ keystream(block_keys[b], row, lane);
+                }
+            }
+
+            CW_FORCEINLINE void decode_into(size_t i, uint8_t* bytes) const {
+                size_t row = row_of(i);
+                for (size_t j = 0; j < sizeof(T); ++j) {
+                    size_t b = byte_block[j];
+                    size_t lane = byte_lane[j];
+                    bytes[j] = blocks[b][row * LANES + lane] ^ keystream(block_keys[b], row, lane);
+                }
+            }
+
+            // reallocate, re-key and re-permute; the plaintext copy is wiped afterwards
+            void grow(size_t min_capacity) {
+                size_t new_cap = cap ? cap : 8;
+                while (new_cap < min_capacity) new_cap <<= 1;
+
+#if CW_ENABLE_SECRET_ARENA
+                // on locked pages; wiped when the buffer is released
+                memory::secret_buffer plain_bytes(count * sizeof(T));
+                T* plain = reinterpret_cast<T*>(plain_bytes.data());
+#else
+                // raw bytes, as above: T need not be default-constructible
+                std::vector<uint8_t> plain_bytes(count * sizeof(T));
+                T* plain = reinterpret_cast<T*>(plain_bytes.data());
+#endif
+                decode(0, count, plain);
+
+                for (auto& block : blocks) {
+                    block = std::make_unique<uint8_t[]>(new_cap * LANES);
+                    for (size_t k = 0; k < new_cap * LANES; k += sizeof(uint64_t)) {
+                        uint64_t noise = CW_RANDOM_RT();
+                        std::memcpy(block.get() + k, &noise, std::min(sizeof(uint64_t), new_cap * LANES - k));
+                    }
+                }
+                cap = new_cap;
+                shuffle_layout();
+
+                for (size_t i = 0; i < count; ++i) {
+                    encode(i, plain[i]);
+                }
+
+#if !CW_ENABLE_SECRET_ARENA
+                secure_wipe(plain, count * sizeof(T));
+#endif
+            }
+
+        public:
+            scattered_vector() = default;
+
+            scattered_vector(const T* data, size_t n) {
+                reserve(n);
+                for (size_t i = 0; i < n; ++i) push_back(data[i]);
+            }
+
+            scattered_vector(std::initializer_list<T> init)
+                : scattered_vector(init.begin(), init.size()) {}
+
+            scattered_vector(const scattered_vector& other) {
+                reserve(other.count);
+                for (size_t i = 0; i < other.count; ++i) push_back(other.get(i));
+            }
+
+            scattered_vector(scattered_vector&& other) noexcept
+                : blocks(std::move(other.blocks)),
+                  block_keys(other.block_keys),
+                  byte_block(other.byte_block),
+                  byte_lane(other.byte_lane),
+                  count(std::exchange(other.count, 0)),
+                  cap(std::exchange(other.cap, 0)),
+                  row_mul(other.row_mul) {}
+
+            scattered_vector& operator=(scattered_vector other) noexcept {
+                std::swap(blocks, other.blocks);
+                std::swap(block_keys, other.block_keys);
+                std::swap(byte_block, other.byte_block);
+                std::swap(byte_lane, other.byte_lane);
+                std::swap(count, other.count);
+                std::swap(cap, other.cap);
+                std::swap(row_mul, other.row_mul);
+                return *this;
+            }
+
+            size_t size() const { return count; }
+            size_t capacity() const { return cap; }
+            bool empty() const { return count == 0; }
+
+            void reserve(size_t n) {
+                if (n > cap) grow(n);
+            }
+
+            void push_back(const T& value) {
+                if (count == cap) grow(count + 1);
+                encode(count++, value);
+            }
+
+            void pop_back() {
+                if (count) --count;
+            }
+
+            void clear() { count = 0; }
+
+            // decoded as bytes, so T need not be default-constructible
+            CW_FORCEINLINE T get(size_t i) const {
+                std::array<uint8_t, sizeof(T)> bytes;
+                decode_into(i, bytes.data());
+                return std::bit_cast<T>(bytes);
+            }
+
+            CW_FORCEINLINE T operator[](size_t i) const { return get(i); }
+
+            CW_FORCEINLINE void set(size_t i, const T& value) {
+                encode(i, value);
+            }
+
+            // batch decode [first, first + n) into a caller-owned buffer
+            void decode(size_t first, size_t n, T* out) const {
+                for (size_t k = 0; k < n; ++k) {
+                    decode_into(first + k, reinterpret_cast<uint8_t*>(out + k));
+                }
+            }
+        };
+    }
+#else
+    namespace data_hiding {
+        template<typename T, size_t Chunks = 8>
+        class scattered_value {
+        private:
+            T value;
+        public:
+            scattered_value() : value{} {}
+            scattered_value(const T& val) : value(val) {}
+            CW_FORCEINLINE T get() const { return value; }
+            CW_FORCEINLINE operator T() const { return value; }
+            CW_FORCEINLINE void set(const T& val) { value = val; }
+        };
+
+        template<typename T>
+        class polymorphic_value {
+        private:
+            T value;
+        public:
+            polymorphic_value() : value{} {}
+            polymorphic_value(T val) : value(val) {}
+            CW_FORCEINLINE T get() const { return value; }
+            CW_FORCEINLINE void set(T val) { value = val; }
+            CW_FORCEINLINE operator T() const { return value; }
+        };
+
+        template<typename T, size_t Blocks = 4>
+        class scattered_vector {
+        private:
+            std::vector<T> values;
+        public:
+            scattered_vector() = default;
+            scattered_vector(const T* data, size_t n) : values(data, data + n) {}
+            scattered_vector(std::initializer_list<T> init) : values(init) {}
+            size_t size() const { return values.size(); }
+            size_t capacity() const { return values.capacity(); }
+            bool empty() const { return values.empty(); }
+            void reserve(size_t n) { values.reserve(n); }
+            void push_back(const T& value) { values.push_back(value); }
+            void pop_back() { if (!values.empty()) values.pop_back(); }
+            void clear() { values.clear(); }
+            CW_FORCEINLINE T get(size_t i) const { return values[i]; }
+            CW_FORCEINLINE T operator[](size_t i) const { return values[i]; }
+            CW_FORCEINLINE void set(size_t i, const T& value) { values[i] = value; }
+            void decode(size_t first, size_t n, T* out) const {
+                std::copy(values.begin() + first, values.begin() + first + n, out);
+            }
+        };
+    }
+#endif
+
+    namespace data_hiding {
+
+        // scattered lookup table built on scattered_vector (follows CW_ENABLE_DATA_HIDING through it)
+        // entries are stored scattered; the open-addressing index only holds entry positions
+        // and a seeded 32-bit hash, so keys never appear in plaintext. lookups compare hashes
+        // first and decode a single entry on a match. erase swaps the last entry into the hole.
+        // not synchronized - treat it like std::unordered_map.
+        template<typename K, typename V, size_t Blocks = 4>
+        class scattered_map {
+        private:
+            static_assert(std::has_unique_object_representations_v<K>, "scattered_map hashes keys by their bytes");
+            static_assert(std::is_trivially_copyable_v<V>, "scattered_map requires a trivially copyable value type");
+
+            struct entry {
+                K key;
+                V value;
+            };
+
+            struct slot {
+                uint32_t position;  // entry index + 1, 0 = empty
+                uint32_t hash;
+            };
+
+            scattered_vector<entry, Blocks> entries;
+            std::vector<slot> index;
+            uint64_t seed = static_cast<uint64_t>(CW_RANDOM_RT());
+
+            CW_FORCEINLINE uint32_t hash_key(const K& key) const {
+                // seeded fnv-1a over the key bytes
+                const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&key);
+                uint64_t hash = 0xcbf29ce484222325ULL ^ seed;
+                for (size_t i = 0; i < sizeof(K); ++i) {
+                    hash ^= bytes[i];
+                    hash *= 0x100000001b3ULL;
+                }
+                return static_cast<uint32_t>(hash ^ (hash >> 32));
+            }
+
+            // slot holding key, or the empty slot where it would go
+            size_t find_slot(const K& key, uint32_t hash) const {
+                size_t mask = index.size() - 1;
+                for (size_t i = hash & mask;; i = (i + 1) & mask) {
+                    const slot& sl = index[i];
+                    if (!sl.position) return i;
+                    if (sl.hash == hash && entries.get(sl.position - 1).key == key) return i;
+                }
+            }
+
+            void rebuild_index(size_t slots) {
+                std::vector<slot> fresh(slots, slot{0, 0});
+                size_t mask = slots - 1;
+                for (const slot& sl : index) {
+                    if (!sl.position) continue;
+                    size_t i = sl.hash & mask;
+                    while (fresh[i].position) i = (i + 1) & mask;
+                    fresh[i] = sl;
+                }
+                index.swap(fresh);
+            }
+
+        public:
+            scattered_map() : index(16, slot{0, 0}) {}
+
+            size_t size() const { return entries.size(); }
+            bool empty() const { return entries.empty(); }
+
+            bool contains(const K& key) const {
+                return index[find_slot(key, hash_key(key))].position != 0;
+            }
+
+            bool try_get(const K& key, V& out) const {
+                const slot& sl = index[find_slot(key, hash_key(key))];
+                if (!sl.position) return false;
+                out = entries.get(sl.position - 1).value;
+                return true;
+            }
+
+            // fallback seeds the result, so V need not be default-constructible
+            V get(const K& key, const V& fallback = V{}) const {
+                V out = fallback;
+                try_get(key, out);
+                return out;
+            }
+
+            // insert or overwrite
+            void set(const K& key, const V& value) {
+                uint32_t hash = hash_key(key);
+                size_t i = find_slot(key, hash);
+                if (index[i].position) {
+                    entries.set(index[i].position - 1, entry{key, value});
+                    return;
+                }
+
+                // keep the load factor at or below one half
+                if ((entries.size() + 1) * 2 > index.size()) {
+                    rebuild_index(index.size() * 2);
+                    i = find_slot(key, hash);
+                }
+                entries.push_back(entry{key, value});
+                index[i] = slot{static_cast<uint32_t>(entries.size()), hash};
+            }
+
+            bool erase(const K& key) {
+                size_t hole = find_slot(key, hash_key(key));
+                if (!index[hole].position) return false;
+                uint32_t removed = index[hole].position;
+
+                // backward-shift deletion keeps linear probe chains intact
+                size_t mask = index.size() - 1;
+                for (size_t j = (hole + 1) & mask; index[j].position; j = (j + 1) & mask) {
+                    size_t home = index[j].hash & mask;
+                    bool stays = (hole <= j) ? (hole < home && home <= j) : (hole < home || home <= j);
+                    if (!stays) {
+                        index[hole] = index[j];
+                        hole = j;
+                    }
+                }
+                index[hole] = slot{0, 0};
+
+                // move the last entry into the freed position
+                uint32_t last = static_cast<uint32_t>(entries.size());
+                if (removed != last) {
+                    entry moved = entries.get(last - 1);
+                    entries.set(removed - 1, moved);
+                    index[find_slot(moved.key, hash_key(moved.key))].position = removed;
+                }
+                entries.pop_back();
+                return true;
+            }
+
+            void clear() {
+                entries.clear();
+                std::fill(index.begin(), index.end(), slot{0, 0});
+            }
+
+            // visits every (key, value) pair, decoding one entry at a time
+            template<typename Fn>
+            void for_each(Fn&& fn) const {
+                for (size_t i = 0; i < entries.size(); ++i) {
+                    entry e = entries.get(i);
+                    fn(e.key, e.value);
+                }
+            }
+        };
+    }
+
+    #if CW_ENABLE_DATA_HIDING
+        #define CW_SCATTER(x) (cloakwork::data_hiding::scattered_value<decltype(x)>{x})
+        #define CW_POLY(x) (cloakwork::data_hiding::polymorphic_value<decltype(x)>{x})
+    #else
+        #define CW_SCATTER(x) (x)
+        #define CW_POLY(x) (x)
+    #endif
+
+} // namespace cloakwork
+
+CW_POP_WARNINGS
+
+#endif // CLOAKWORK_DATA_HIDING_H
@@ -0,0 +1,253 @@
+#ifndef CLOAKWORK_FUNCTION_H
+#define CLOAKWORK_FUNCTION_H
+
+// cloakwork/function.h - function pointer obfuscation and dispatch tables (CW_CALL)
+
+#include "anti_debug.h"
+
+#include <initializer_list>
+
+CW_PUSH_WARNINGS
+
+namespace cloakwork {
+
+    // =================================================================
+    // function pointer obfuscation and indirection
+    // =================================================================
+
+#if CW_ENABLE_FUNCTION_OBFUSCATION
+    namespace detail {
+        // shared pool of pointer-shaped noise, created once for the whole process.
+        // every call site drops its encoded pointer into a random slot, so a memory scan
+        // finds one table of indistinguishable values instead of a real pointer per site.
+        // the call path never reads the pool.
+        class call_decoy_pool {
+        public:
+            static constexpr size_t SLOTS = 64;
+
+            static call_decoy_pool& instance() {
+                static call_decoy_pool pool;
+                return pool;
+            }
+
+            void deposit(uintptr_t encoded) {
+                slots[CW_RANDOM_RT() % SLOTS].store(encoded, std::memory_order_relaxed);
+            }
+
+        private:
+            std::atomic<uintptr_t> slots[SLOTS];
+
+            call_decoy_pool() {
+                for (auto& slot : slots) {
+                    slot.store(static_cast<uintptr_t>(CW_RANDOM_RT()) << 17 ^ CW_RANDOM_RT(), std::memory_order_relaxed);
+                }
+            }
+        };
+    }
+
+    // Key is fixed at compile time, so decoding is three ALU ops on a register.
+    // CW_CALL builds one static instance per call site with its own key; constructing
+    // obfuscated_call directly still works but shares the key of the instantiation.
+    template<typename Func, uint64_t Key = CW_RANDOM_CT64(), typename Level = level::standard>
+    class obfuscated_call {
+    private:
+        static constexpr uintptr_t XOR_KEY = static_cast<uintptr_t>(Key);
+        static constexpr uintptr_t ADD_KEY = static_cast<uintptr_t>(std::rotl(Key, 29)) | 1;
+        static constexpr int ROTATION = static_cast<int>(Key >> 58) % 31 + 1;
+
+        // periodic inline checks, counted per thread so no counter is shared (0 = none)
+        static constexpr uint32_t CHECK_PERIOD = level_traits<Level>::call_check_period;
+
+        uintptr_t encoded;
+
+        static CW_FORCEINLINE uintptr_t encode(Func* ptr) {
+            uintptr_t addr = std::bit_cast<uintptr_t>(ptr);
+            return std::rotr((addr ^ XOR_KEY) + ADD_KEY, ROTATION);
+        }
+
+        CW_FORCEINLINE Func* decode() const {
+            uintptr_t addr = encoded;
+            CW_REGISTER_BARRIER(addr);  // stop the optimizer folding encode/decode
+            return std::bit_cast<Func*>((std::rotl(addr, ROTATION) - ADD_KEY) ^ XOR_KEY);
+        }
+
+    public:
+        obfuscated_call(Func* func) : encoded(encode(func)) {
+            detail::call_decoy_pool::instance().deposit(encoded);
+        }
+
+        template<typename... Args>
+        CW_FORCEINLINE decltype(auto) operator()(Args&&... args) const {
+            if constexpr (CHECK_PERIOD != 0) {
+                thread_local uint32_t calls_left = CHECK_PERIOD;
+                if (--calls_left == 0) [[unlikely]] {
+                    calls_left = CHECK_PERIOD;
+                    CW_INLINE_CHECK();
+                }
+            }
+
+            return decode()(std::forward<Args>(args)...);
+        }
+    };
+
+    // table of encrypted function pointers (plugin hooks, opcode handlers).
+    // all slots share one key schedule and sit in a contiguous cache-line-aligned array;
+    // a lookup is one rotate/sub/xor on the slot. set() and rekey() must not race with lookups.
+    template<typename Sig, size_t N>
+    class obfuscated_dispatch_table;
+
+    template<typename R, typename... Args, size_t N>
+    class alignas(64) obfuscated_dispatch_table<R(Args...), N> {
+    public:
+        using signature = R(Args...);
+        static constexpr size_t CACHE_LINE = 64;
+
+    private:
+        struct key_schedule {
+            uintptr_t xor_key;
+            uintptr_t add_key;
+            int rotation;
+        };
+
+        key_schedule keys;
+        alignas(CACHE_LINE) uintptr_t slots[N];
+
+        static key_schedule make_keys() {
+            key_schedule k;
+            k.xor_key = static_cast<uintptr_t>(CW_RANDOM_RT()) << 17 ^ CW_RANDOM_RT();
+            k.add_key = (static_cast<uintptr_t>(CW_RANDOM_RT()) << 23 ^ CW_RANDOM_RT()) | 1;
+            k.rotation = static_cast<int>(CW_RANDOM_RT() % 31) + 1;
+            return k;
+        }
+
+        // the slot index is folded into the xor key so equal handlers encode differently
+        static CW_FORCEINLINE uintptr_t encode(const key_schedule& k, size_t i, signature* func) {
+            uintptr_t addr = std::bit_cast<uintptr_t>(func);
+            return std::rotr((addr ^ (k.xor_key + i)) + k.add_key, k.rotation);
+        }
+
+        static CW_FORCEINLINE signature* decode(const key_schedule& k, size_t i, uintptr_t enc) {
+            return std::bit_cast<signature*>((std::rotl(enc, k.rotation) - k.add_key) ^ (k.xor_key + i));
+        }
+
+    public:
+        obfuscated_dispatch_table() : keys(make_keys()) {
+            for (size_t i = 0; i < N; ++i) slots[i] = encode(keys, i, nullptr);
+        }
+
+        obfuscated_dispatch_table(std::initializer_list<signature*> funcs) : obfuscated_dispatch_table() {
+            size_t i = 0;
+            for (signature* func : funcs) {
+                if (i == N) break;
+                set(i++, func);
+            }
+        }
+
+        static constexpr size_t size() { return N; }
+
+        CW_FORCEINLINE void set(size_t i, signature* func) {
+            slots[i] = encode(keys, i, func);
+        }
+
+        CW_FORCEINLINE signature* get(size_t i) const {
+            return decode(keys, i, slots[i]);
+        }
+
+        template<typename... CallArgs>
+        CW_FORCEINLINE decltype(auto) operator()(size_t i, CallArgs&&... args) const {
+            return get(i)(std::forward<CallArgs>(args)...);
+        }
+
+        // re-encrypt every slot under a fresh key schedule in one pass
+        void rekey() {
+            key_schedule next = make_keys();
+            for (size_t i = 0; i < N; ++i) {
+                slots[i] = encode(next, i, decode(keys, i, slots[i]));
+            }
+            keys = next;
+        }
+    };
+#else
+    template<typename Func, uint64_t Key = 0, typename Level = level::standard>
+    class obfuscated_call {
+    private:
+        Func* func_ptr;
+    public:
+        obfuscated_call(Func* func) : func_ptr(func) {}
+        template<typename... Args>
+        CW_FORCEINLINE decltype(auto) operator()(Args&&... args) const {
+            return func_ptr(std::forward<Args>(args)...);
+        }
+    };
+
+    template<typename Sig, size_t N>
+    class obfuscated_dispatch_table;
+
+    template<typename R, typename... Args, size_t N>
+    class alignas(64) obfuscated_dispatch_table<R(Args...), N> {
+    public:
+        using signature = R(Args...);
+        static constexpr size_t CACHE_LINE = 64;
+    private:
+        signature* slots[N] = {};
+    public:
+        obfuscated_dispatch_table() = default;
+        obfuscated_dispatch_table(std::initializer_list<signature*> funcs) {
+            size_t i = 0;
+            for (signature* func : funcs) {
+                if (i == N) break;
+                slots[i++] = func;
+            }
+        }
+        static constexpr size_t size() { return N; }
+        CW_FORCEINLINE void set(size_t i, signature* func) { slots[i] = func; }
+        CW_FORCEINLINE signature* get(size_t i) const { return slots[i]; }
+        template<typename... CallArgs>
+        CW_FORCEINLINE decltype(auto) operator()(size_t i, CallArgs&&... args) const {
+            return slots[i](std::forward<CallArgs>(args)...);
+        }
+        void rekey() {}
+    };
+#endif
+
+#if CW_ENABLE_PROFILING
+    // what CW_CALL hands out under profiling: the probe spans the decode and the call,
+    // not just the fetch of the per-site static
+    template<typename Call>
+    class profiled_call {
+    public:
+        profiled_call(const Call& call, const profiling::site_info& site) : call(call), site(site) {}
+
+        template<typename... Args>
+        CW_FORCEINLINE decltype(auto) operator()(Args&&... args) const {
+            profiling::probe timed{site};
+            return call(std::forward<Args>(args)...);
+        }
+
+    private:
+        const Call& call;
+        const profiling::site_info& site;
+    };
+#endif
+
+    #if CW_ENABLE_FUNCTION_OBFUSCATION && CW_ENABLE_PROFILING
+        #define CW_CALL_P(func, lvl) ([]() { \
+            static const cloakwork::obfuscated_call<decltype(func), CW_RANDOM_CT64(), CW_LEVEL_TYPE(lvl)> site{func}; \
+            return cloakwork::profiled_call{site, CW_PROFILE_SITE("CW_CALL")}; }())
+        #define CW_CALL(func) CW_CALL_P(func, CW_DEFAULT_LEVEL)
+    #elif CW_ENABLE_FUNCTION_OBFUSCATION
+        // one static instance per call site: built on first use, keyed at compile time
+        #define CW_CALL_P(func, lvl) ([]() -> const auto& { \
+            static const cloakwork::obfuscated_call<decltype(func), CW_RANDOM_CT64(), CW_LEVEL_TYPE(lvl)> site{func}; \
+            return site; }())
+        #define CW_CALL(func) CW_CALL_P(func, CW_DEFAULT_LEVEL)
+    #else
+        #define CW_CALL(func) (func)
+        #define CW_CALL_P(func, lvl) (func)
+    #endif
+
+} // namespace cloakwork
+
+CW_POP_WARNINGS
+
+#endif // CLOAKWORK_FUNCTION_H
@@ -0,0 +1,348 @@
+#ifndef CLOAKWORK_HASH_H
+#define CLOAKWORK_HASH_H
+
+// cloakwork/hash.h - compile-time/runtime string hashing (CW_HASH) and the crc32 engine
+
+#include "core.h"
+
+// hardware crc32c: msvc uses the sse4.2 intrinsics, gcc/clang emit the instruction through
+// inline asm so the header needs no per-function target options on x86
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define CW_CRC_X86 1
+    #if defined(_MSC_VER)
+        #include <nmmintrin.h>
+    #else
+        #include <cpuid.h>
+    #endif
+#elif defined(__aarch64__) && defined(__linux__) && !defined(_MSC_VER)
+    #define CW_CRC_ARM64 1
+    #include <arm_acle.h>
+    #include <sys/auxv.h>
+#endif
+
+CW_PUSH_WARNINGS
+
+namespace cloakwork {
+
+    // =================================================================
+    // compile-time string hashing
+    // =================================================================
+
+    namespace hash {
+        // fnv-1a hash for compile-time string hashing
+        consteval uint32_t fnv1a(const char* str, size_t len) {
+            uint32_t hash = 0x811c9dc5;
+            for (size_t i = 0; i < len; ++i) {
+                hash ^= static_cast<uint8_t>(str[i]);
+                hash *= 0x01000193;
+            }
+            return hash;
+        }
+
+        // consteval version for string literals
+        template<size_t N>
+        consteval uint32_t fnv1a(const char (&str)[N]) {
+            return fnv1a(str, N - 1);
+        }
+
+        // wide string version
+        consteval uint32_t fnv1a_wide(const wchar_t* str, size_t len) {
+            uint32_t hash = 0x811c9dc5;
+            for (size_t i = 0; i < len; ++i) {
+                hash ^= static_cast<uint8_t>(str[i] & 0xFF);
+                hash *= 0x01000193;
+                hash ^= static_cast<uint8_t>((str[i] >> 8) & 0xFF);
+                hash *= 0x01000193;
+            }
+            return hash;
+        }
+
+        template<size_t N>
+        consteval uint32_t fnv1a_wide(const wchar_t (&str)[N]) {
+            return fnv1a_wide(str, N - 1);
+        }
+
+        // runtime hash for dynamic strings
+        CW_FORCEINLINE uint32_t fnv1a_runtime(const char* str) {
+            uint32_t hash = 0x811c9dc5;
+            while (*str) {
+                hash ^= static_cast<uint8_t>(*str++);
+                hash *= 0x01000193;
+            }
+            return hash;
+        }
+
+        CW_FORCEINLINE uint32_t fnv1a_runtime(const wchar_t* str) {
+            uint32_t hash = 0x811c9dc5;
+            while (*str) {
+                hash ^= static_cast<uint8_t>(*str & 0xFF);
+                hash *= 0x01000193;
+                hash ^= static_cast<uint8_t>((*str >> 8) & 0xFF);
+                hash *= 0x01000193;
+                ++str;
+            }
+            return hash;
+        }
+
+        // case-insensitive runtime hash
+        CW_FORCEINLINE uint32_t fnv1a_runtime_ci(const char* str) {
+            uint32_t hash = 0x811c9dc5;
+            while (*str) {
+                char c = *str++;
+                if (c >= 'A' && c <= 'Z') c += 32;
+                hash ^= static_cast<uint8_t>(c);
+                hash *= 0x01000193;
+            }
+            return hash;
+        }
+
+        CW_FORCEINLINE uint32_t fnv1a_runtime_ci(const wchar_t* str) {
+            uint32_t hash = 0x811c9dc5;
+            while (*str) {
+                wchar_t c = *str++;
+                if (c >= L'A' && c <= L'Z') c += 32;
+                hash ^= static_cast<uint8_t>(c & 0xFF);
+                hash *= 0x01000193;
+                hash ^= static_cast<uint8_t>((c >> 8) & 0xFF);
+                hash *= 0x01000193;
+            }
+            return hash;
+        }
+
+        // case-insensitive wide-to-ascii runtime hash
+        // (hashes wide string as if it were ascii - for comparing against CW_HASH_CI)
+        CW_FORCEINLINE uint32_t fnv1a_runtime_ci_w2a(const wchar_t* str) {
+            uint32_t hash = 0x811c9dc5;
+            while (*str) {
+                wchar_t c = *str++;
+                if (c >= L'A' && c <= L'Z') c += 32;
+                // only use low byte (ascii portion) to match CW_HASH_CI behavior
+                hash ^= static_cast<uint8_t>(c & 0xFF);
+                hash *= 0x01000193;
+            }
+            return hash;
+        }
+
+        // case-insensitive compile-time hash (for module names)
+        consteval uint32_t fnv1a_ci(const char* str, size_t len) {
+            uint32_t hash = 0x811c9dc5;
+            for (size_t i = 0; i < len; ++i) {
+                char c = str[i];
+                if (c >= 'A' && c <= 'Z') c += 32;
+                hash ^= static_cast<uint8_t>(c);
+                hash *= 0x01000193;
+            }
+            return hash;
+        }
+
+        template<size_t N>
+        consteval uint32_t fnv1a_ci(const char (&str)[N]) {
+            return fnv1a_ci(str, N - 1);
+        }
+    }
+
+    // compile-time hash macro
+    #define CW_HASH(s) ([]() consteval { return cloakwork::hash::fnv1a(s); }())
+    #define CW_HASH_WIDE(s) ([]() consteval { return cloakwork::hash::fnv1a_wide(s); }())
+    #define CW_HASH_CI(s) ([]() consteval { return cloakwork::hash::fnv1a_ci(s); }())
+
+    // =================================================================
+    // crc32 engine
+    // =================================================================
+
+    namespace crc {
+        // reflected polynomials
+        inline constexpr uint32_t CRC32_POLY = 0xEDB88320;     // ieee 802.3 (zlib, png)
+        inline constexpr uint32_t CRC32C_POLY = 0x82F63B78;    // castagnoli (sse4.2 / armv8 crc32c)
+
+        // slicing-by-8 tables, generated at compile time
+        template<uint32_t Poly>
+        constexpr std::array<std::array<uint32_t, 256>, 8> make_tables() {
+            std::array<std::array<uint32_t, 256>, 8> t{};
+            for (uint32_t i = 0; i < 256; ++i) {
+                uint32_t c = i;
+                for (int j = 0; j < 8; ++j) {
+                    c = (c >> 1) ^ (Poly & (0 - (c & 1)));
+                }
+                t[0][i] = c;
+            }
+            for (uint32_t i = 0; i < 256; ++i) {
+                for (size_t k = 1; k < 8; ++k) {
+                    t[k][i] = (t[k - 1][i] >> 8) ^ t[0][t[k - 1][i] & 0xFF];
+                }
+            }
+            return t;
+        }
+
+        template<uint32_t Poly>
+        inline constexpr auto tables = make_tables<Poly>();
+
+        // byte-at-a-time update, usable in constant evaluation.
+        // crc is the running value in its inverted form (start with ~0)
+        template<uint32_t Poly>
+        constexpr uint32_t update_bytewise(uint32_t crc, const uint8_t* data, size_t length) {
+            for (size_t i = 0; i < length; ++i) {
+                crc = (crc >> 8) ^ tables<Poly>[0][(crc ^ data[i]) & 0xFF];
+            }
+            return crc;
+        }
+
+        // slicing-by-8: eight table lookups per 64-bit word
+        template<uint32_t Poly>
+        inline uint32_t update_slicing8(uint32_t crc, const uint8_t* data, size_t length) {
+            const auto& t = tables<Poly>;
+            while (length >= 8) {
+                uint32_t lo, hi;
+                if constexpr (std::endian::native == std::endian::little) {
+                    std::memcpy(&lo, data, 4);
+                    std::memcpy(&hi, data + 4, 4);
+                } else {
+                    lo = data[0] | data[1] << 8 | data[2] << 16 | static_cast<uint32_t>(data[3]) << 24;
+                    hi = data[4] | data[5] << 8 | data[6] << 16 | static_cast<uint32_t>(data[7]) << 24;
+                }
+                lo ^= crc;
+                crc = t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF] ^ t[5][(lo >> 16) & 0xFF] ^ t[4][lo >> 24] ^
+                      t[3][hi & 0xFF] ^ t[2][(hi >> 8) & 0xFF] ^ t[1][(hi >> 16) & 0xFF] ^ t[0][hi >> 24];
+                data += 8;
+                length -= 8;
+            }
+            return update_bytewise<Poly>(crc, data, length);
+        }
+
+        namespace detail {
+#if defined(CW_CRC_X86)
+    #if defined(_MSC_VER)
+            CW_FORCEINLINE uint32_t crc32c_u8(uint32_t crc, uint8_t v) { return _mm_crc32_u8(crc, v); }
+            CW_FORCEINLINE uint32_t crc32c_u32(uint32_t crc, uint32_t v) { return _mm_crc32_u32(crc, v); }
+        #if defined(_M_X64)
+            CW_FORCEINLINE uint64_t crc32c_u64(uint64_t crc, uint64_t v) { return _mm_crc32_u64(crc, v); }
+        #endif
+    #else
+            CW_FORCEINLINE uint32_t crc32c_u8(uint32_t crc, uint8_t v) { asm("crc32b %1, %0" : "+r"(crc) : "rm"(v)); return crc; }
+            CW_FORCEINLINE uint32_t crc32c_u32(uint32_t crc, uint32_t v) { asm("crc32l %1, %0" : "+r"(crc) : "rm"(v)); return crc; }
+        #if defined(__x86_64__)
+            CW_FORCEINLINE uint64_t crc32c_u64(uint64_t crc, uint64_t v) { asm("crc32q %1, %0" : "+r"(crc) : "rm"(v)); return crc; }
+        #endif
+    #endif
+
+            inline uint32_t crc32c_hw(uint32_t crc, const uint8_t* data, size_t length) {
+    #if defined(__x86_64__) || defined(_M_X64)
+                uint64_t crc64 = crc;
+                while (length >= 8) {
+                    uint64_t word;
+                    std::memcpy(&word, data, 8);
+                    crc64 = crc32c_u64(crc64, word);
+                    data += 8;
+                    length -= 8;
+                }
+                crc = static_cast<uint32_t>(crc64);
+    #endif
+                while (length >= 4) {
+                    uint32_t word;
+                    std::memcpy(&word, data, 4);
+                    crc = crc32c_u32(crc, word);
+                    data += 4;
+                    length -= 4;
+                }
+                while (length--) {
+                    crc = crc32c_u8(crc, *data++);
+                }
+                return crc;
+            }
+
+            inline bool crc32c_hw_available() {
+    #if defined(_MSC_VER)
+                int regs[4];
+                __cpuid(regs, 1);
+                return (regs[2] & (1 << 20)) != 0;
+    #else
+                unsigned int eax, ebx, ecx, edx;
+                return __get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & bit_SSE4_2);
+    #endif
+            }
+#elif defined(CW_CRC_ARM64)
+            __attribute__((target("+crc")))
+            inline uint32_t crc32c_hw(uint32_t crc, const uint8_t* data, size_t length) {
+                while (length >= 8) {
+                    uint64_t word;
+                    std::memcpy(&word, data, 8);
+                    crc = __crc32cd(crc, word);
+                    data += 8;
+                    length -= 8;
+                }
+                while (length--) {
+                    crc = __crc32cb(crc, *data++);
+                }
+                return crc;
+            }
+
+            inline bool crc32c_hw_available() {
+                return (getauxval(AT_HWCAP) & (1UL << 7)) != 0;  // HWCAP_CRC32
+            }
+#else
+            inline uint32_t crc32c_hw(uint32_t crc, const uint8_t* data, size_t length) {
+                return update_slicing8<CRC32C_POLY>(crc, data, length);
+            }
+
+            inline bool crc32c_hw_available() { return false; }
+#endif
+
+            using update_fn = uint32_t(*)(uint32_t, const uint8_t*, size_t);
+
+            // picked once per process
+            inline update_fn crc32c_impl() {
+                static const update_fn impl = crc32c_hw_available() ? &crc32c_hw : &update_slicing8<CRC32C_POLY>;
+                return impl;
+            }
+        }
+
+        inline bool hardware_accelerated() {
+            return detail::crc32c_impl() != &update_slicing8<CRC32C_POLY>;
+        }
+
+        // standard crc-32 (ieee), slicing-by-8. pass a previous result as `seed` to continue it
+        inline uint32_t crc32(const void* data, size_t length, uint32_t seed = 0) {
+            return ~update_slicing8<CRC32_POLY>(~seed, static_cast<const uint8_t*>(data), length);
+        }
+
+        // crc-32c (castagnoli), hardware instruction when the cpu has it, slicing-by-8 otherwise
+        inline uint32_t crc32c(const void* data, size_t length, uint32_t seed = 0) {
+            return ~detail::crc32c_impl()(~seed, static_cast<const uint8_t*>(data), length);
+        }
+
+        // compile-time variants for precomputing expected hashes at build time
+        consteval uint32_t crc32_ct(const char* str, size_t length) {
+            uint32_t crc = 0xFFFFFFFF;
+            for (size_t i = 0; i < length; ++i) {
+                crc = (crc >> 8) ^ tables<CRC32_POLY>[0][(crc ^ static_cast<uint8_t>(str[i])) & 0xFF];
+            }
+            return ~crc;
+        }
+
+        consteval uint32_t crc32c_ct(const char* str, size_t length) {
+            uint32_t crc = 0xFFFFFFFF;
+            for (size_t i = 0; i < length; ++i) {
+                crc = (crc >> 8) ^ tables<CRC32C_POLY>[0][(crc ^ static_cast<uint8_t>(str[i])) & 0xFF];
+            }
+            return ~crc;
+        }
+
+        template<size_t N>
+        consteval uint32_t crc32_ct(const std::array<uint8_t, N>& bytes) {
+            return ~update_bytewise<CRC32_POLY>(0xFFFFFFFF, bytes.data(), N);
+        }
+
+        template<size_t N>
+        consteval uint32_t crc32c_ct(const std::array<uint8_t, N>& bytes) {
+            return ~update_bytewise<CRC32C_POLY>(0xFFFFFFFF, bytes.data(), N);
+        }
+    }
+
+    #define CW_CRC32(s) ([]() consteval { return cloakwork::crc::crc32_ct(s, sizeof(s) - 1); }())
+    #define CW_CRC32C(s) ([]() consteval { return cloakwork::crc::crc32c_ct(s, sizeof(s) - 1); }())
+
+} // namespace cloakwork
+
+CW_POP_WARNINGS
+
+#endif // CLOAKWORK_HASH_H
@@ -0,0 +1,271 @@
+#ifndef CLOAKWORK_IMPORTS_H
+#define CLOAKWORK_IMPORTS_H
+
+// cloakwork/imports.h - import hiding, direct syscalls and return address spoofing (windows)
+
+#include "hash.h"
+#include "platform.h"
+
+CW_PUSH_WARNINGS
+
+namespace cloakwork {
+
+    // =================================================================
+    // import hiding and dynamic API resolution
+    // =================================================================
+
+#if CW_ENABLE_IMPORT_HIDING
+    namespace imports {
+
+        // get module base by walking PEB
+        CW_FORCEINLINE void* getModuleBase(uint32_t moduleHash) {
+#ifdef _WIN32
+            CW_SEH_TRY {
+#ifdef _WIN64
+                auto peb = reinterpret_cast<PEB*>(__readgsqword(0x60));
+#else
+                auto peb = reinterpret_cast<PEB*>(__readfsdword(0x30));
+#endif
+                if (!peb || !peb->Ldr) return nullptr;
+
+                auto ldr = peb->Ldr;
+                auto head = &ldr->InMemoryOrderModuleList;
+
+                for (auto curr = head->Flink; curr != head; curr = curr->Flink) {
+                    // use our full structure definition
+                    auto entry = CONTAINING_RECORD(curr, cloakwork_internal::CW_LDR_DATA_TABLE_ENTRY, InMemoryOrderLinks);
+                    if (!entry->BaseDllName.Buffer) continue;
+
+                    // use wide-to-ascii hash to match CW_HASH_CI (ascii) against wide string from PEB
+                    uint32_t modHash = hash::fnv1a_runtime_ci_w2a(entry->BaseDllName.Buffer);
+                    if (modHash == moduleHash) {
+                        return entry->DllBase;
+                    }
+                }
+            }
+            CW_SEH_EXCEPT {
+                return nullptr;
+            }
+#endif
+            return nullptr;
+        }
+
+        // get function address by walking export table
+        CW_FORCEINLINE void* getProcAddress(void* module, uint32_t funcHash) {
+#ifdef _WIN32
+            if (!module) return nullptr;
+
+            CW_SEH_TRY {
+                auto dos = static_cast<IMAGE_DOS_HEADER*>(module);
+                if (dos->e_magic != IMAGE_DOS_SIGNATURE) return nullptr;
+
+                auto nt = reinterpret_cast<IMAGE_NT_HEADERS*>(
+                    reinterpret_cast<uint8_t*>(module) + dos->e_lfanew);
+                if (nt->Signature != IMAGE_NT_SIGNATURE) return nullptr;
+
+                auto exportDir = nt->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_EXPORT];
+                if (exportDir.VirtualAddress == 0) return nullptr;
+
+                auto exports = reinterpret_cast<IMAGE_EXPORT_DIRECTORY*>(
+                    reinterpret_cast<uint8_t*>(module) + exportDir.VirtualAddress);
+
+                auto names = reinterpret_cast<uint32_t*>(
+                    reinterpret_cast<uint8_t*>(module) + exports->AddressOfNames);
+                auto ordinals = reinterpret_cast<uint16_t*>(
+                    reinterpret_cast<uint8_t*>(module) + exports->AddressOfNameOrdinals);
+                auto functions = reinterpret_cast<uint32_t*>(
+                    reinterpret_cast<uint8_t*>(module) + exports->AddressOfFunctions);
+
+                for (uint32_t i = 0; i < exports->NumberOfNames; ++i) {
+                    auto name = reinterpret_cast<const char*>(
+                        reinterpret_cast<uint8_t*>(module) + names[i]);
+
+                    if (hash::fnv1a_runtime(name) == funcHash) {
+                        uint32_t funcRva = functions[ordinals[i]];
+
+                        // check for forwarded export
+                        if (funcRva >= exportDir.VirtualAddress &&
+                            funcRva < exportDir.VirtualAddress + exportDir.Size) {
+                            // forwarded export - not handling for simplicity
+                            return nullptr;
+                        }
+
+                        return reinterpret_cast<uint8_t*>(module) + funcRva;
+                    }
+                }
+            }
+            CW_SEH_EXCEPT {
+                return nullptr;
+            }
+#endif
+            return nullptr;
+        }
+
+        // cached import resolution
+        template<uint32_t ModuleHash, uint32_t FuncHash>
+        CW_FORCEINLINE void* getCachedImport() {
+            static void* cached = nullptr;
+            if (!cached) {
+                void* mod = getModuleBase(ModuleHash);
+                if (mod) cached = getProcAddress(mod, FuncHash);
+            }
+            return cached;
+        }
+    }
+
+    // macro for hidden imports (uses case-insensitive hash for module names)
+    #define CW_IMPORT(mod, func) \
+        reinterpret_cast<decltype(&func)>( \
+            cloakwork::imports::getCachedImport<CW_HASH_CI(mod), CW_HASH(#func)>())
+
+    #define CW_IMPORT_WIDE(mod, func) \
+        reinterpret_cast<decltype(&func)>( \
+            cloakwork::imports::getCachedImport<CW_HASH_WIDE(mod), CW_HASH(#func)>())
+#else
+    namespace imports {
+        inline void* getModuleBase(uint32_t) { return nullptr; }
+        inline void* getProcAddress(void*, uint32_t) { return nullptr; }
+    }
+    #define CW_IMPORT(mod, func) (&func)
+    #define CW_IMPORT_WIDE(mod, func) (&func)
+#endif
+
+    // =================================================================
+    // direct syscalls
+    // =================================================================
+
+#if CW_ENABLE_SYSCALLS
+    namespace syscall {
+
+        // get syscall number from ntdll function
+        CW_FORCEINLINE uint32_t getSyscallNumber(uint32_t funcHash) {
+#ifdef _WIN32
+            CW_SEH_TRY {
+                void* ntdll = imports::getModuleBase(CW_HASH_CI("ntdll.dll"));
+                if (!ntdll) return 0;
+
+                auto func = reinterpret_cast<uint8_t*>(imports::getProcAddress(ntdll, funcHash));
+                if (!func) return 0;
+
+                // pattern: mov r10, rcx; mov eax, <syscall_number>
+                // 4C 8B D1 B8 XX XX XX XX
+                if (func[0] == 0x4C && func[1] == 0x8B && func[2] == 0xD1 && func[3] == 0xB8) {
+                    return *reinterpret_cast<uint32_t*>(func + 4);
+                }
+
+                // alternative pattern for older windows
+                // B8 XX XX XX XX
+                if (func[0] == 0xB8) {
+                    return *reinterpret_cast<uint32_t*>(func + 1);
+                }
+            }
+            CW_SEH_EXCEPT {
+                return 0;
+            }
+#endif
+            return 0;
+        }
+
+        // cached syscall number
+        template<uint32_t FuncHash>
+        CW_FORCEINLINE uint32_t getCachedSyscallNumber() {
+            static uint32_t cached = 0;
+            if (cached == 0) {
+                cached = getSyscallNumber(FuncHash);
+            }
+            return cached;
+        }
+
+#ifdef _WIN64
+        // x64 syscall invoker - uses inline assembly via intrinsic workaround
+        // note: actual syscall invocation requires asm. this provides the infrastructure.
+        extern "C" NTSTATUS __syscall_stub(uint32_t syscallNumber, ...);
+#endif
+    }
+
+    #define CW_SYSCALL_NUMBER(func) (cloakwork::syscall::getCachedSyscallNumber<CW_HASH(#func)>())
+#else
+    namespace syscall {
+        inline uint32_t getSyscallNumber(uint32_t) { return 0; }
+    }
+    #define CW_SYSCALL_NUMBER(func) (0)
+#endif
+
+    // =================================================================
+    // return address spoofing
+    // =================================================================
+
+#if CW_ENABLE_FUNCTION_OBFUSCATION
+    namespace spoof {
+
+        // find a "ret" gadget in a legitimate module
+        CW_FORCEINLINE void* findRetGadget() {
+#ifdef _WIN32
+            CW_SEH_TRY {
+                void* ntdll = imports::getModuleBase(CW_HASH_CI("ntdll.dll"));
+                if (!ntdll) return nullptr;
+
+                auto dos = static_cast<IMAGE_DOS_HEADER*>(ntdll);
+                auto nt = reinterpret_cast<IMAGE_NT_HEADERS*>(
+                    reinterpret_cast<uint8_t*>(ntdll) + dos->e_lfanew);
+
+                auto base = reinterpret_cast<uint8_t*>(ntdll);
+                size_t size = nt->OptionalHeader.SizeOfImage;
+
+                // search for ret (0xC3) gadget
+                for (size_t i = 0; i < size - 1; ++i) {
+                    if (base[i] == 0xC3) {
+                        return base + i;
+                    }
+                }
+            }
+            CW_SEH_EXCEPT {
+                return nullptr;
+            }
+#endif
+            return nullptr;
+        }
+
+        // cached ret gadget
+        CW_FORCEINLINE void* getRetGadget() {
+            static void* gadget = nullptr;
+            if (!gadget) {
+                gadget = findRetGadget();
+            }
+            return gadget;
+        }
+
+        // spoofed call wrapper - stores real return address and uses gadget
+        // note: full implementation requires asm for stack manipulation
+        template<typename Ret, typename... Args>
+        class spoofed_call {
+        private:
+            using FuncPtr = Ret(*)(Args...);
+            FuncPtr func;
+            void* gadget;
+
+        public:
+            spoofed_call(FuncPtr f) : func(f), gadget(getRetGadget()) {}
+
+            CW_FORCEINLINE Ret operator()(Args... args) {
+                // simplified version - full spoof requires asm
+                CW_COMPILER_BARRIER();
+                return func(args...);
+            }
+        };
+    }
+
+    #define CW_SPOOF_CALL(func) (cloakwork::spoof::spoofed_call<decltype(func)>{func})
+#else
+    namespace spoof {
+        inline void* findRetGadget() { return nullptr; }
+        inline void* getRetGadget() { return nullptr; }
+    }
+    #define CW_SPOOF_CALL(func) (func)
+#endif
+
+} // namespace cloakwork
+
+CW_POP_WARNINGS
+
+#endif // CLOAKWORK_IMPORTS_H
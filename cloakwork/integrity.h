@@ -0,0 +1,657 @@
+#ifndef CLOAKWORK_INTEGRITY_H
+#define CLOAKWORK_INTEGRITY_H
+
+// cloakwork/integrity.h - hook detection, chunked/background integrity verification and
+// post-link precomputed hashes (CW_INTEGRITY_CHECK, CW_INTEGRITY_TICK, CW_INTEGRITY_PRECOMPUTED)
+
+#include "hash.h"
+#include "platform.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+    #include <link.h>
+#endif
+
+CW_PUSH_WARNINGS
+
+namespace cloakwork {
+
+    // =================================================================
+    // self-integrity verification
+    // =================================================================
+
+    namespace integrity {
+        // hash_entry markers, shared with tools/cw_hashgen.cpp (which builds with everything disabled)
+        inline constexpr uint32_t HASH_ENTRY_MAGIC = 0x48574343;   // "CCWH"
+        inline constexpr uint32_t HASH_ENTRY_PATCHED = 1;
+    }
+
+#if CW_ENABLE_INTEGRITY_CHECKS
+    namespace integrity {
+
+        // compute hash of memory region
+        CW_FORCEINLINE uint32_t computeHash(const void* data, size_t size) {
+            const uint8_t* bytes = static_cast<const uint8_t*>(data);
+            uint32_t hash = 0x811c9dc5;
+
+            for (size_t i = 0; i < size; ++i) {
+                hash ^= bytes[i];
+                hash *= 0x01000193;
+            }
+
+            return hash;
+        }
+
+        // lane-parallel chunk hash: eight independent 32-bit fnv lanes over 32-byte blocks,
+        // so the compiler can keep them in one vector register
+        inline uint64_t chunk_hash(const void* data, size_t size) {
+            const uint8_t* bytes = static_cast<const uint8_t*>(data);
+            uint32_t lanes[8];
+            for (uint32_t l = 0; l < 8; ++l) lanes[l] = 0x811c9dc5 + l;
+
+            size_t i = 0;
+            for (; i + 32 <= size; i += 32) {
+                uint32_t words[8];
+                std::memcpy(words, bytes + i, 32);
+                for (size_t l = 0; l < 8; ++l) {
+                    lanes[l] = (lanes[l] ^ words[l]) * 0x01000193;
+                }
+            }
+            for (; i < size; ++i) {
+                lanes[i & 7] = (lanes[i & 7] ^ bytes[i]) * 0x01000193;
+            }
+
+            uint64_t hash = size;
+            for (size_t l = 0; l < 8; ++l) {
+                hash = (hash ^ lanes[l]) * 0x100000001B3ULL;
+                hash ^= hash >> 29;
+            }
+            return hash;
+        }
+
+        // a memory range split into fixed chunks with precomputed hashes,
+        // so it can be verified one bounded piece at a time
+        class chunked_region {
+        public:
+            static constexpr size_t DEFAULT_CHUNK_SIZE = 4096;
+
+            chunked_region() = default;
+
+            chunked_region(const void* start, size_t length, size_t chunk = DEFAULT_CHUNK_SIZE)
+                : base(static_cast<const uint8_t*>(start)), size(length), chunk_size(chunk ? chunk : DEFAULT_CHUNK_SIZE) {
+                hashes.resize((size + chunk_size - 1) / chunk_size);
+                for (size_t i = 0; i < hashes.size(); ++i) {
+                    hashes[i] = chunk_hash(chunk_address(i), chunk_length(i));
+                }
+            }
+
+            size_t chunk_count() const { return hashes.size(); }
+            const uint8_t* address() const { return base; }
+            size_t length() const { return size; }
+
+            const uint8_t* chunk_address(size_t i) const { return base + i * chunk_size; }
+            size_t chunk_length(size_t i) const { return std::min(chunk_size, size - i * chunk_size); }
+            uint64_t expected_hash(size_t i) const { return hashes[i]; }
+
+            bool verify_chunk(size_t i) const {
+                return chunk_hash(chunk_address(i), chunk_length(i)) == hashes[i];
+            }
+
+            bool verify() const {
+                for (size_t i = 0; i < hashes.size(); ++i) {
+                    if (!verify_chunk(i)) return false;
+                }
+                return true;
+            }
+
+        private:
+            const uint8_t* base = nullptr;
+            size_t size = 0;
+            size_t chunk_size = DEFAULT_CHUNK_SIZE;
+            std::vector<uint64_t> hashes;
+        };
+
+        // integrity-checked function wrapper
+        // every 100th call verifies one chunk of the function, cycling through all of them,
+        // so the cost of a check does not grow with the function size
+        template<typename Func>
+        class integrity_checked {
+        private:
+            static constexpr size_t CHUNK_SIZE = 256;
+
+            Func* func;
+            chunked_region region;
+            mutable std::atomic<uint32_t> checkCount{0};
+
+        public:
+            integrity_checked(Func* f, size_t size)
+                : func(f), region(reinterpret_cast<const void*>(f), size, CHUNK_SIZE) {}
+
+            template<typename... Args>
+            CW_FORCEINLINE auto operator()(Args&&... args) {
+                // periodic integrity check
+                uint32_t count = ++checkCount;
+                if ((count % 100) == 0 && region.chunk_count()) {
+                    if (!region.verify_chunk((count / 100) % region.chunk_count())) {
+                        // tampered - crash
+#if CW_ANTI_DEBUG_RESPONSE == 1
+                        CW_DEBUGBREAK();
+                        *(volatile int*)0 = 0;
+#endif
+                    }
+                }
+
+                return func(std::forward<Args>(args)...);
+            }
+
+            bool verify() const {
+                return region.verify();
+            }
+        };
+
+        // build-time expected hashes
+        // CW_INTEGRITY_PRECOMPUTED(func) places a hash_entry for func in the "cwhashes" section.
+        // the post-link tool (tools/cw_hashgen.cpp) fills in the real symbol size and its crc32c,
+        // so nothing is hashed at startup and no size has to be guessed.
+        // entries the tool has not patched yet are skipped: precomputed() is false, verify() true
+
+        // layout shared with tools/cw_hashgen.cpp (32 bytes on 64-bit targets)
+        template<typename Func>
+        struct alignas(8) hash_entry {
+            uint32_t magic;
+            uint32_t flags;
+            Func* func;
+            uint64_t size;
+            uint32_t crc;
+            uint32_t reserved;
+        };
+
+        // the tool writes these fields after linking, so the compiler must not fold them
+        template<typename T>
+        CW_FORCEINLINE T read_patched(const T& field) {
+            return *static_cast<const volatile T*>(&field);
+        }
+
+        template<typename Func>
+        class precomputed_checked {
+        private:
+            Func* func;
+            const hash_entry<Func>* entry;
+            mutable std::atomic<uint32_t> checkCount{0};
+
+        public:
+            precomputed_checked(Func* f, const hash_entry<Func>* e) : func(f), entry(e) {}
+
+            bool precomputed() const { return (read_patched(entry->flags) & HASH_ENTRY_PATCHED) != 0; }
+            size_t size() const { return static_cast<size_t>(read_patched(entry->size)); }
+
+            bool verify() const {
+                if (!precomputed()) return true;
+                return crc::crc32c(reinterpret_cast<const void*>(func), size()) == read_patched(entry->crc);
+            }
+
+            template<typename... Args>
+            CW_FORCEINLINE auto operator()(Args&&... args) {
+                // periodic integrity check
+                if ((++checkCount % 100) == 0 && !verify()) {
+                    // tampered - crash
+#if CW_ANTI_DEBUG_RESPONSE == 1
+                    CW_DEBUGBREAK();
+                    *(volatile int*)0 = 0;
+#endif
+                }
+
+                return func(std::forward<Args>(args)...);
+            }
+        };
+
+#if defined(__ELF__)
+        // section bounds defined by the linker; weak so binaries without entries still link
+        extern "C" const char __start_cwhashes[] __attribute__((weak));
+        extern "C" const char __stop_cwhashes[] __attribute__((weak));
+
+        // walks every entry in the cwhashes section (linker-provided bounds).
+        // returns false if any patched entry no longer matches its function
+        inline bool verify_precomputed(size_t* checked = nullptr) {
+            struct raw_entry {
+                uint32_t magic;
+                uint32_t flags;
+                uintptr_t func;
+                uint64_t size;
+                uint32_t crc;
+                uint32_t reserved;
+            };
+
+            const char* at = __start_cwhashes;
+            const char* end = __stop_cwhashes;
+            size_t count = 0;
+            bool clean = true;
+
+            if (at && end) {
+                while (at + sizeof(raw_entry) <= end) {
+                    raw_entry e;
+                    std::memcpy(&e, at, sizeof(e));
+                    if (e.magic != HASH_ENTRY_MAGIC) {
+                        at += alignof(raw_entry);
+                        continue;
+                    }
+                    if (e.flags & HASH_ENTRY_PATCHED) {
+                        clean &= crc::crc32c(reinterpret_cast<const void*>(e.func), static_cast<size_t>(e.size)) == e.crc;
+                        ++count;
+                    }
+                    at += sizeof(raw_entry);
+                }
+            }
+
+            if (checked) *checked = count;
+            return clean;
+        }
+#else
+        inline bool verify_precomputed(size_t* checked = nullptr) {
+            if (checked) *checked = 0;
+            return true;
+        }
+#endif
+
+        // incremental integrity engine
+        // owns a set of registered code/data ranges and verifies a few chunks per tick,
+        // round-robin, so the whole image is covered over time at a bounded cost per call
+        class integrity_engine {
+        public:
+            struct violation {
+                const void* address;    // start of the tampered chunk
+                size_t size;
+                uint64_t expected;
+                uint64_t actual;
+            };
+
+            static integrity_engine& instance() {
+                static integrity_engine engine;
+                return engine;
+            }
+
+            // returns a region id for unregister_range
+            size_t register_range(const void* start, size_t length, size_t chunk_size = chunked_region::DEFAULT_CHUNK_SIZE) {
+                chunked_region region(start, length, chunk_size);
+                std::lock_guard<std::mutex> lock(mtx);
+                regions.push_back({next_id, std::move(region)});
+                return next_id++;
+            }
+
+            void unregister_range(size_t id) {
+                std::lock_guard<std::mutex> lock(mtx);
+                for (size_t i = 0; i < regions.size(); ++i) {
+                    if (regions[i].id == id) {
+                        regions.erase(regions.begin() + i);
+                        if (cursor_region >= regions.size()) cursor_region = 0;
+                        cursor_chunk = 0;
+                        return;
+                    }
+                }
+            }
+
+            // registers every read-only section (code and constant data) of the module
+            // containing `address_in_module`; defaults to the module cloakwork was compiled into.
+            // returns the number of ranges registered
+            size_t register_module_sections(const void* address_in_module = nullptr) {
+                if (!address_in_module) address_in_module = reinterpret_cast<const void*>(&instance);
+                size_t registered = 0;
+#ifdef _WIN32
+                HMODULE module = nullptr;
+                if (!GetModuleHandleExA(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+                                        static_cast<LPCSTR>(address_in_module), &module) || !module) {
+                    return 0;
+                }
+
+                auto* base = reinterpret_cast<const uint8_t*>(module);
+                auto* dos = reinterpret_cast<const IMAGE_DOS_HEADER*>(base);
+                auto* nt = reinterpret_cast<const IMAGE_NT_HEADERS*>(base + dos->e_lfanew);
+                const IMAGE_SECTION_HEADER* section = IMAGE_FIRST_SECTION(nt);
+
+                for (WORD i = 0; i < nt->FileHeader.NumberOfSections; ++i, ++section) {
+                    DWORD flags = section->Characteristics;
+                    if ((flags & IMAGE_SCN_MEM_WRITE) || !(flags & (IMAGE_SCN_MEM_EXECUTE | IMAGE_SCN_MEM_READ))) continue;
+                    if (!section->Misc.VirtualSize) continue;
+                    register_range(base + section->VirtualAddress, section->Misc.VirtualSize);
+                    ++registered;
+                }
+#elif defined(__linux__)
+                struct search {
+                    integrity_engine* engine;
+                    uintptr_t target;
+                    size_t registered;
+                } ctx{this, reinterpret_cast<uintptr_t>(address_in_module), 0};
+
+                dl_iterate_phdr([](dl_phdr_info* info, size_t, void* data) -> int {
+                    auto* ctx = static_cast<search*>(data);
+
+                    // is the target inside one of this module's segments?
+                    bool owns_target = false;
+                    for (ElfW(Half) i = 0; i < info->dlpi_phnum; ++i) {
+                        const ElfW(Phdr)& ph = info->dlpi_phdr[i];
+                        uintptr_t start = info->dlpi_addr + ph.p_vaddr;
+                        if (ph.p_type == PT_LOAD && ctx->target >= start && ctx->target < start + ph.p_memsz) {
+                            owns_target = true;
+                            break;
+                        }
+                    }
+                    if (!owns_target) return 0;
+
+                    for (ElfW(Half) i = 0; i < info->dlpi_phnum; ++i) {
+                        const ElfW(Phdr)& ph = info->dlpi_phdr[i];
+                        if (ph.p_type != PT_LOAD || (ph.p_flags & PF_W) || !ph.p_memsz) continue;
+                        // only the file-backed part: bss-like tails are never read-only code
+                        ctx->engine->register_range(reinterpret_cast<const void*>(info->dlpi_addr + ph.p_vaddr), ph.p_filesz);
+                        ++ctx->registered;
+                    }
+                    return 1;
+                }, &ctx);
+
+                registered = ctx.registered;
+#endif
+                return registered;
+            }
+
+            using violation_handler = std::function<void(const violation&)>;
+
+            // called once per tampered chunk, outside the engine lock.
+            // with no handler set, violations are only counted and reported by return values
+            void set_violation_handler(violation_handler handler) {
+                std::lock_guard<std::mutex> lock(mtx);
+                on_violation = std::move(handler);
+            }
+
+            // verifies the next `chunks` chunks; returns false if any of them was modified.
+            // if another thread is already ticking, returns true without doing anything
+            bool tick(size_t chunks = 4) {
+                std::unique_lock<std::mutex> lock(mtx, std::try_to_lock);
+                if (!lock.owns_lock()) return true;
+
+                pending.clear();
+                verify_next(chunks, SIZE_MAX);
+                return report(lock);
+            }
+
+            // cooperative hook for an event loop: verifies chunks until at least `max_bytes`
+            // have been hashed (always at least one chunk, at most one full pass). returns the
+            // number of bytes hashed
+            size_t pump(size_t max_bytes) {
+                std::unique_lock<std::mutex> lock(mtx);
+                pending.clear();
+                size_t bytes = verify_next(SIZE_MAX, max_bytes);
+                report(lock);
+                return bytes;
+            }
+
+            // verifies every chunk of every region
+            bool verify_all() {
+                std::unique_lock<std::mutex> lock(mtx);
+                pending.clear();
+                for (const auto& entry : regions) {
+                    for (size_t i = 0; i < entry.region.chunk_count(); ++i) {
+                        check_chunk(entry.region, i);
+                    }
+                }
+                return report(lock);
+            }
+
+            size_t chunk_count() const {
+                std::lock_guard<std::mutex> lock(mtx);
+                size_t total = 0;
+                for (const auto& entry : regions) total += entry.region.chunk_count();
+                return total;
+            }
+
+            size_t violation_count() const { return violations.load(std::memory_order_relaxed); }
+
+            violation last_violation() const {
+                std::lock_guard<std::mutex> lock(mtx);
+                return last;
+            }
+
+        private:
+            struct entry {
+                size_t id;
+                chunked_region region;
+            };
+
+            mutable std::mutex mtx;
+            std::vector<entry> regions;
+            size_t next_id = 1;
+            size_t cursor_region = 0;
+            size_t cursor_chunk = 0;
+            std::atomic<size_t> violations{0};
+            violation last{};
+            violation_handler on_violation;
+            std::vector<violation> pending;
+
+            integrity_engine() = default;
+
+            // caller holds mtx. advances the round-robin cursor, stopping after
+            // max_chunks chunks, once max_bytes have been hashed, or after one full pass -
+            // so an unlimited budget (SIZE_MAX) still returns and releases the lock
+            size_t verify_next(size_t max_chunks, size_t max_bytes) {
+                size_t total = 0;
+                for (const auto& entry : regions) total += entry.region.chunk_count();
+                max_chunks = std::min(max_chunks, total);
+
+                size_t bytes = 0;
+                for (size_t n = 0; n < max_chunks && bytes < max_bytes;) {
+                    const chunked_region& region = regions[cursor_region].region;
+                    if (cursor_chunk < region.chunk_count()) {
+                        check_chunk(region, cursor_chunk);
+                        bytes += region.chunk_length(cursor_chunk);
+                        ++n;
+                    }
+                    if (++cursor_chunk >= region.chunk_count()) {
+                        cursor_chunk = 0;
+                        cursor_region = (cursor_region + 1) % regions.size();
+                    }
+                }
+                return bytes;
+            }
+
+            // caller holds mtx
+            bool check_chunk(const chunked_region& region, size_t i) {
+                uint64_t actual = chunk_hash(region.chunk_address(i), region.chunk_length(i));
+                if (actual == region.expected_hash(i)) return true;
+
+                last = {region.chunk_address(i), region.chunk_length(i), region.expected_hash(i), actual};
+                violations.fetch_add(1, std::memory_order_relaxed);
+                pending.push_back(last);
+                return false;
+            }
+
+            // releases the lock, then hands this pass's violations to the handler
+            bool report(std::unique_lock<std::mutex>& lock) {
+                if (pending.empty()) return true;
+
+                std::vector<violation> found;
+                found.swap(pending);
+                violation_handler handler = on_violation;
+                lock.unlock();
+
+                if (handler) {
+                    for (const violation& v : found) handler(v);
+                }
+                return false;
+            }
+        };
+
+        // opt-in background verification worker
+        // drives integrity_engine::pump() from its own thread under a budget, so request
+        // threads never pay for hashing. the slice per wake-up is bytes_per_second * interval
+        // (one full pass when bytes_per_second is 0), and after each slice the worker sleeps
+        // long enough to stay under cpu_percent.
+        // violations go to the engine's violation handler
+        struct verifier_budget {
+            size_t bytes_per_second = 16 * 1024 * 1024;     // 0 = one full pass per wake-up
+            uint32_t cpu_percent = 2;                        // 0 = no cpu limit, else 1..100
+            std::chrono::milliseconds interval{100};         // wake-up period
+        };
+
+        class background_verifier {
+        public:
+            using budget = verifier_budget;
+
+            explicit background_verifier(budget limits = {}, integrity_engine& target = integrity_engine::instance())
+                : engine(target), limits(limits) {
+                worker = std::thread([this] { run(); });
+            }
+
+            background_verifier(const background_verifier&) = delete;
+            background_verifier& operator=(const background_verifier&) = delete;
+
+            ~background_verifier() {
+                stop();
+            }
+
+            void stop() {
+                {
+                    std::lock_guard<std::mutex> lock(mtx);
+                    stopping = true;
+                }
+                cv.notify_all();
+                if (worker.joinable()) worker.join();
+            }
+
+            size_t bytes_verified() const { return verified.load(std::memory_order_relaxed); }
+
+        private:
+            integrity_engine& engine;
+            budget limits;
+            std::thread worker;
+            std::mutex mtx;
+            std::condition_variable cv;
+            bool stopping = false;
+            std::atomic<size_t> verified{0};
+
+            void run() {
+                using clock = std::chrono::steady_clock;
+                const auto interval = std::max(limits.interval, std::chrono::milliseconds(1));
+                const uint32_t cpu = std::min<uint32_t>(limits.cpu_percent, 100);
+
+                size_t slice = SIZE_MAX;
+                if (limits.bytes_per_second) {
+                    slice = std::max<size_t>(1, static_cast<size_t>(
+                        static_cast<double>(limits.bytes_per_second) * interval.count() / 1000.0));
+                }
+
+                std::unique_lock<std::mutex> lock(mtx);
+                while (!stopping) {
+                    lock.unlock();
+                    auto start = clock::now();
+                    verified.fetch_add(engine.pump(slice), std::memory_order_relaxed);
+                    auto busy = clock::now() - start;
+                    lock.lock();
+
+                    clock::duration pause = interval - std::min<clock::duration>(busy, interval);
+                    if (cpu) {
+                        pause = std::max<clock::duration>(pause, busy * (100 - cpu) / cpu);
+                    }
+                    cv.wait_for(lock, pause, [this] { return stopping; });
+                }
+            }
+        };
+
+        // check for common hook patterns at function start
+        CW_FORCEINLINE bool detectHook(const void* func) {
+#ifdef _WIN32
+            const uint8_t* bytes = static_cast<const uint8_t*>(func);
+
+            // check for jmp rel32 (E9 XX XX XX XX)
+            if (bytes[0] == 0xE9) return true;
+
+            // check for jmp [rip+disp32] (FF 25 XX XX XX XX)
+            if (bytes[0] == 0xFF && bytes[1] == 0x25) return true;
+
+            // check for mov rax, addr; jmp rax (48 B8 XX XX XX XX XX XX XX XX FF E0)
+            if (bytes[0] == 0x48 && bytes[1] == 0xB8) return true;
+
+            // check for push addr; ret (68 XX XX XX XX C3)
+            if (bytes[0] == 0x68 && bytes[5] == 0xC3) return true;
+
+            // check for int3 breakpoint
+            if (bytes[0] == 0xCC) return true;
+#endif
+            return false;
+        }
+
+        // verify multiple functions at once
+        template<typename... Funcs>
+        CW_FORCEINLINE bool verifyFunctions(Funcs*... funcs) {
+            return ((!detectHook(reinterpret_cast<const void*>(funcs))) && ...);
+        }
+    }
+
+    #define CW_INTEGRITY_CHECK(func, size) \
+        (cloakwork::integrity::integrity_checked<decltype(func)>{&func, size})
+
+    #define CW_DETECT_HOOK(func) \
+        (cloakwork::integrity::detectHook(reinterpret_cast<const void*>(&func)))
+
+    #define CW_INTEGRITY_TICK() (cloakwork::integrity::integrity_engine::instance().tick())
+
+    #ifdef _MSC_VER
+        #pragma section("cwhashes", read, write)
+    #endif
+    #define CW_INTEGRITY_PRECOMPUTED(func) \
+        ([]() -> cloakwork::integrity::precomputed_checked<decltype(func)> { \
+            CW_SECTION("cwhashes") static cloakwork::integrity::hash_entry<decltype(func)> entry{ \
+                cloakwork::integrity::HASH_ENTRY_MAGIC, 0, &func, 0, 0, 0}; \
+            return {&func, &entry}; }())
+#else
+    namespace integrity {
+        inline uint32_t computeHash(const void*, size_t) { return 0; }
+        inline uint64_t chunk_hash(const void*, size_t) { return 0; }
+        inline bool verify_precomputed(size_t* checked = nullptr) { if (checked) *checked = 0; return true; }
+        class integrity_engine {
+        public:
+            struct violation { const void* address; size_t size; uint64_t expected; uint64_t actual; };
+            static integrity_engine& instance() { static integrity_engine engine; return engine; }
+            size_t register_range(const void*, size_t, size_t = 4096) { return 0; }
+            void unregister_range(size_t) {}
+            size_t register_module_sections(const void* = nullptr) { return 0; }
+            using violation_handler = std::function<void(const violation&)>;
+            void set_violation_handler(violation_handler) {}
+            bool tick(size_t = 4) { return true; }
+            size_t pump(size_t) { return 0; }
+            bool verify_all() { return true; }
+            size_t chunk_count() const { return 0; }
+            size_t violation_count() const { return 0; }
+            violation last_violation() const { return {}; }
+        };
+        struct verifier_budget {
+            size_t bytes_per_second = 16 * 1024 * 1024;
+            uint32_t cpu_percent = 2;
+            std::chrono::milliseconds interval{100};
+        };
+        class background_verifier {
+        public:
+            using budget = verifier_budget;
+            explicit background_verifier(budget = {}, integrity_engine& = integrity_engine::instance()) {}
+            void stop() {}
+            size_t bytes_verified() const { return 0; }
+        };
+        inline bool detectHook(const void*) { return false; }
+        template<typename... Funcs>
+        inline bool verifyFunctions(Funcs*...) { return true; }
+    }
+    #define CW_INTEGRITY_CHECK(func, size) (&func)
+    #define CW_DETECT_HOOK(func) (false)
+    #define CW_INTEGRITY_TICK() (true)
+    #define CW_INTEGRITY_PRECOMPUTED(func) (&func)
+#endif
+
+} // namespace cloakwork
+
+CW_POP_WARNINGS
+
+#endif // CLOAKWORK_INTEGRITY_H
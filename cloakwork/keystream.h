@@ -0,0 +1,350 @@
+#ifndef CLOAKWORK_KEYSTREAM_H
+#define CLOAKWORK_KEYSTREAM_H
+
+// cloakwork/keystream.h - arx counter-mode keystream (chacha-style, configurable rounds).
+//
+// the keystream is a function of (key, nonce, 64-byte block counter), so the same object
+// encrypts a literal at compile time and decrypts any byte range of it at runtime in
+// O(range). long runs go through a multi-block kernel that computes 8 blocks at once, one
+// block per vector lane (avx2 / sse2 / neon through generic vectors, sse2 on msvc).
+
+#include "core.h"
+
+// rounds of the arx permutation: 8 is fast and plenty for obfuscation, 20 is full chacha
+#ifndef CW_ARX_ROUNDS
+    #define CW_ARX_ROUNDS 8
+#endif
+
+// baseline x86 builds only get sse2; kernels that benefit from avx2 get a second copy picked
+// at runtime. gcc before 14 cannot write target attributes into a module interface
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && !defined(__AVX2__) && \
+    !(defined(__cpp_modules) && !defined(__clang__) && __GNUC__ < 14)
+    #define CW_AVX2_DISPATCH 1
+#endif
+
+// the multi-block kernel transposes lanes with __builtin_shufflevector (clang, gcc 12+)
+#if defined(__GNUC__) && defined(__has_builtin)
+    #if __has_builtin(__builtin_shufflevector)
+        #define CW_ARX_VECTOR 1
+    #endif
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #include <emmintrin.h>
+#endif
+
+CW_PUSH_WARNINGS
+
+namespace cloakwork {
+
+    // =================================================================
+    // arx counter-mode keystream
+    // =================================================================
+
+    namespace stream {
+
+        namespace detail {
+            // one chacha quarter round. V is uint32_t for the scalar/constexpr path and a
+            // vector of lanes for the multi-block kernels
+            template<typename V>
+            CW_FORCEINLINE constexpr void quarter_round(V& a, V& b, V& c, V& d) {
+                a += b; d ^= a; d = (d << 16) | (d >> 16);
+                c += d; b ^= c; b = (b << 12) | (b >> 20);
+                a += b; d ^= a; d = (d << 8) | (d >> 24);
+                c += d; b ^= c; b = (b << 7) | (b >> 25);
+            }
+
+            template<int Rounds, typename V>
+            CW_FORCEINLINE constexpr void permute(V (&x)[16]) {
+                for (int r = 0; r < Rounds; r += 2) {
+                    quarter_round(x[0], x[4], x[8], x[12]);
+                    quarter_round(x[1], x[5], x[9], x[13]);
+                    quarter_round(x[2], x[6], x[10], x[14]);
+                    quarter_round(x[3], x[7], x[11], x[15]);
+                    quarter_round(x[0], x[5], x[10], x[15]);
+                    quarter_round(x[1], x[6], x[11], x[12]);
+                    quarter_round(x[2], x[7], x[8], x[13]);
+                    quarter_round(x[3], x[4], x[9], x[14]);
+                }
+            }
+
+            // keystream block `counter` of `state` (constants, key, -, -, nonce)
+            template<int Rounds>
+            constexpr void block(const uint32_t (&state)[16], uint64_t counter, uint32_t (&out)[16]) {
+                uint32_t x[16] = {};
+                for (int i = 0; i < 16; ++i) x[i] = state[i];
+                x[12] = static_cast<uint32_t>(counter);
+                x[13] = static_cast<uint32_t>(counter >> 32);
+                uint32_t in12 = x[12], in13 = x[13];
+                permute<Rounds>(x);
+                for (int i = 0; i < 16; ++i) out[i] = x[i] + state[i];
+                out[12] = x[12] + in12;
+                out[13] = x[13] + in13;
+            }
+
+#if defined(CW_AVX2_DISPATCH)
+            inline bool avx2_available() {
+                static const bool available = __builtin_cpu_supports("avx2");
+                return available;
+            }
+#endif
+
+            // xors `groups` runs of 8 blocks (512 bytes) starting at block (hi:lo). lo must not
+            // wrap inside the call
+#if defined(CW_ARX_VECTOR)
+            typedef uint32_t arx_vec __attribute__((vector_size(32)));
+
+            // rows x[first..first+7] to columns: unpack 32-bit, then 64-bit, then 128-bit halves
+            CW_FORCEINLINE void transpose8(const arx_vec (&x)[16], int first, arx_vec (&cols)[8]) {
+                const arx_vec* r = x + first;
+                arx_vec s[8], u[8];
+                for (int i = 0; i < 8; i += 2) {
+                    s[i]     = __builtin_shufflevector(r[i], r[i + 1], 0, 8, 1, 9, 4, 12, 5, 13);
+                    s[i + 1] = __builtin_shufflevector(r[i], r[i + 1], 2, 10, 3, 11, 6, 14, 7, 15);
+                }
+                for (int i = 0; i < 8; i += 4) {
+                    u[i]     = __builtin_shufflevector(s[i], s[i + 2], 0, 1, 8, 9, 4, 5, 12, 13);
+                    u[i + 1] = __builtin_shufflevector(s[i], s[i + 2], 2, 3, 10, 11, 6, 7, 14, 15);
+                    u[i + 2] = __builtin_shufflevector(s[i + 1], s[i + 3], 0, 1, 8, 9, 4, 5, 12, 13);
+                    u[i + 3] = __builtin_shufflevector(s[i + 1], s[i + 3], 2, 3, 10, 11, 6, 7, 14, 15);
+                }
+                for (int i = 0; i < 4; ++i) {
+                    cols[i]     = __builtin_shufflevector(u[i], u[i + 4], 0, 1, 2, 3, 8, 9, 10, 11);
+                    cols[i + 4] = __builtin_shufflevector(u[i], u[i + 4], 4, 5, 6, 7, 12, 13, 14, 15);
+                }
+            }
+
+            template<int Rounds>
+            CW_FORCEINLINE void blocks_vector(uint8_t* dst, const uint8_t* src, size_t groups,
+                                              const uint32_t (&state)[16], uint32_t lo, uint32_t hi) {
+                const arx_vec lanes = { 0, 1, 2, 3, 4, 5, 6, 7 };
+                const arx_vec zero = {};
+                for (size_t g = 0; g < groups; ++g) {
+                    const arx_vec in12 = lanes + (lo + static_cast<uint32_t>(g * 8));
+                    const arx_vec in13 = zero + hi;
+                    arx_vec x[16];
+                    for (int i = 0; i < 16; ++i) x[i] = i == 12 ? in12 : i == 13 ? in13 : zero + state[i];
+
+                    permute<Rounds>(x);
+
+                    for (int w = 0; w < 16; ++w) x[w] += w == 12 ? in12 : w == 13 ? in13 : zero + state[w];
+                    if constexpr (std::endian::native == std::endian::big) {
+                        for (int w = 0; w < 16; ++w) {
+                            for (int l = 0; l < 8; ++l) x[w][l] = __builtin_bswap32(x[w][l]);
+                        }
+                    }
+
+                    // lane b of vector w is word w of block b: transpose 8x8 twice so that
+                    // lo[b] / hi[b] hold words 0-7 / 8-15 of block b
+                    arx_vec lo_cols[8], hi_cols[8];
+                    transpose8(x, 0, lo_cols);
+                    transpose8(x, 8, hi_cols);
+
+                    const uint8_t* in = src + g * 512;
+                    uint8_t* out = dst + g * 512;
+                    for (int b = 0; b < 8; ++b) {
+                        arx_vec d0, d1;
+                        std::memcpy(&d0, in + b * 64, 32);
+                        std::memcpy(&d1, in + b * 64 + 32, 32);
+                        d0 ^= lo_cols[b];
+                        d1 ^= hi_cols[b];
+                        std::memcpy(out + b * 64, &d0, 32);
+                        std::memcpy(out + b * 64 + 32, &d1, 32);
+                    }
+                }
+            }
+
+    #if defined(CW_AVX2_DISPATCH)
+            template<int Rounds>
+            __attribute__((target("avx2")))
+            void blocks_avx2(uint8_t* dst, const uint8_t* src, size_t groups, const uint32_t (&state)[16],
+                             uint32_t lo, uint32_t hi) {
+                blocks_vector<Rounds>(dst, src, groups, state, lo, hi);
+            }
+    #endif
+
+            template<int Rounds>
+            inline void blocks(uint8_t* dst, const uint8_t* src, size_t groups, const uint32_t (&state)[16],
+                               uint32_t lo, uint32_t hi) {
+    #if defined(CW_AVX2_DISPATCH)
+                if (avx2_available()) {
+                    blocks_avx2<Rounds>(dst, src, groups, state, lo, hi);
+                    return;
+                }
+    #endif
+                blocks_vector<Rounds>(dst, src, groups, state, lo, hi);
+            }
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+            // msvc has no generic vectors: four blocks per __m128i, twice per group
+            struct sse_vec {
+                __m128i v;
+                sse_vec& operator+=(sse_vec o) { v = _mm_add_epi32(v, o.v); return *this; }
+                sse_vec& operator^=(sse_vec o) { v = _mm_xor_si128(v, o.v); return *this; }
+                sse_vec operator<<(int n) const { return { _mm_slli_epi32(v, n) }; }
+                sse_vec operator>>(int n) const { return { _mm_srli_epi32(v, n) }; }
+                sse_vec operator|(sse_vec o) const { return { _mm_or_si128(v, o.v) }; }
+            };
+
+            template<int Rounds>
+            inline void blocks(uint8_t* dst, const uint8_t* src, size_t groups, const uint32_t (&state)[16],
+                               uint32_t lo, uint32_t hi) {
+                alignas(16) uint32_t ks[16][4];
+                uint32_t words[16];
+                for (size_t q = 0; q < groups * 2; ++q) {
+                    sse_vec x[16];
+                    for (int i = 0; i < 16; ++i) x[i].v = _mm_set1_epi32(static_cast<int>(state[i]));
+                    const uint32_t first = lo + static_cast<uint32_t>(q * 4);
+                    x[12].v = _mm_add_epi32(_mm_setr_epi32(0, 1, 2, 3), _mm_set1_epi32(static_cast<int>(first)));
+                    x[13].v = _mm_set1_epi32(static_cast<int>(hi));
+                    const sse_vec in12 = x[12], in13 = x[13];
+
+                    permute<Rounds>(x);
+
+                    for (int w = 0; w < 16; ++w) {
+                        sse_vec v = x[w];
+                        v += w == 12 ? in12 : w == 13 ? in13 : sse_vec{ _mm_set1_epi32(static_cast<int>(state[w])) };
+                        _mm_store_si128(reinterpret_cast<__m128i*>(ks[w]), v.v);
+                    }
+                    const uint8_t* in = src + q * 256;
+                    uint8_t* out = dst + q * 256;
+                    for (int b = 0; b < 4; ++b) {
+                        std::memcpy(words, in + b * 64, 64);
+                        for (int w = 0; w < 16; ++w) words[w] ^= ks[w][b];
+                        std::memcpy(out + b * 64, words, 64);
+                    }
+                }
+                secure_wipe(ks, sizeof(ks));
+                secure_wipe(words, sizeof(words));
+            }
+#else
+            template<int Rounds>
+            inline void blocks(uint8_t* dst, const uint8_t* src, size_t groups, const uint32_t (&state)[16],
+                               uint32_t lo, uint32_t hi) {
+                const uint64_t first = static_cast<uint64_t>(hi) << 32 | lo;
+                uint32_t ks[16];
+                for (size_t b = 0; b < groups * 8; ++b) {
+                    block<Rounds>(state, first + b, ks);
+                    for (int i = 0; i < 64; ++i) {
+                        dst[b * 64 + i] = src[b * 64 + i] ^ static_cast<uint8_t>(ks[i / 4] >> (8 * (i % 4)));
+                    }
+                }
+                secure_wipe(ks, sizeof(ks));
+            }
+#endif
+        }
+
+        // keyed stream: 256-bit key, 64-bit nonce, 64-bit block counter. byte i of the stream is
+        // byte (i % 64) of block (i / 64), words little-endian
+        template<int Rounds = CW_ARX_ROUNDS>
+        class arx_stream {
+            static_assert(Rounds >= 2 && Rounds % 2 == 0, "arx rounds must be a positive even number");
+
+        public:
+            static constexpr int rounds = Rounds;
+
+            constexpr arx_stream() = default;
+
+            constexpr arx_stream(const std::array<uint32_t, 8>& key, uint64_t nonce) {
+                state[0] = 0x61707865; state[1] = 0x3320646e;   // "expand 32-byte k"
+                state[2] = 0x79622d32; state[3] = 0x6b206574;
+                for (int i = 0; i < 8; ++i) state[4 + i] = key[i];
+                state[14] = static_cast<uint32_t>(nonce);
+                state[15] = static_cast<uint32_t>(nonce >> 32);
+            }
+
+            constexpr arx_stream(uint64_t k0, uint64_t k1, uint64_t k2, uint64_t k3, uint64_t nonce)
+                : arx_stream(std::array<uint32_t, 8>{
+                      static_cast<uint32_t>(k0), static_cast<uint32_t>(k0 >> 32),
+                      static_cast<uint32_t>(k1), static_cast<uint32_t>(k1 >> 32),
+                      static_cast<uint32_t>(k2), static_cast<uint32_t>(k2 >> 32),
+                      static_cast<uint32_t>(k3), static_cast<uint32_t>(k3 >> 32) }, nonce) {}
+
+            constexpr void block(uint64_t counter, uint32_t (&out)[16]) const {
+                detail::block<Rounds>(state, counter, out);
+            }
+
+            // single keystream byte. constexpr, but computes a whole block - prefer transform/apply
+            constexpr uint8_t byte_at(uint64_t position) const {
+                uint32_t ks[16];
+                block(position / 64, ks);
+                const uint8_t byte = static_cast<uint8_t>(ks[(position % 64) / 4] >> (8 * (position % 4)));
+                if (!std::is_constant_evaluated()) secure_wipe(ks, sizeof(ks));
+                return byte;
+            }
+
+            // xors the keystream into data[0, length) taken as stream bytes [offset, offset + length).
+            // scalar and constexpr, one block computation per 64 bytes; used for compile-time encryption.
+            // at runtime the keystream block is wiped on the way out
+            template<typename C>
+            constexpr void transform(C* data, size_t length, uint64_t offset = 0) const {
+                static_assert(sizeof(C) == 1, "transform works on byte-sized elements");
+                uint32_t ks[16] = {};
+                size_t i = 0;
+                while (i < length) {
+                    const uint64_t position = offset + i;
+                    block(position / 64, ks);
+                    for (size_t b = static_cast<size_t>(position % 64); b < 64 && i < length; ++b, ++i) {
+                        data[i] = static_cast<C>(static_cast<uint8_t>(data[i]) ^ static_cast<uint8_t>(ks[b / 4] >> (8 * (b % 4))));
+                    }
+                }
+                if (!std::is_constant_evaluated()) secure_wipe(ks, sizeof(ks));
+            }
+
+            // runtime version of transform from src into dst (dst may equal src), using the
+            // multi-block kernel for every full run of 8 blocks
+            void apply(void* dst, const void* src, size_t length, uint64_t offset) const {
+                uint8_t* out = static_cast<uint8_t*>(dst);
+                const uint8_t* in = static_cast<const uint8_t*>(src);
+
+                // partial block in front
+                if (offset % 64 && length) {
+                    const size_t n = 64 - static_cast<size_t>(offset % 64) < length ? 64 - static_cast<size_t>(offset % 64) : length;
+                    xor_scalar(out, in, n, offset);
+                    out += n; in += n; length -= n; offset += n;
+                }
+
+                uint64_t counter = offset / 64;
+                while (length >= 512) {
+                    const uint32_t lo = static_cast<uint32_t>(counter);
+                    const uint64_t room = ((uint64_t(1) << 32) - lo) / 8;  // groups before the high counter word changes
+                    size_t groups = length / 512;
+                    if (room < groups) groups = static_cast<size_t>(room);
+                    if (groups == 0) break;
+
+                    detail::blocks<Rounds>(out, in, groups, state, lo, static_cast<uint32_t>(counter >> 32));
+                    out += groups * 512;
+                    in += groups * 512;
+                    length -= groups * 512;
+                    counter += groups * 8;
+                }
+
+                // a tail of more than one block still goes through the kernel, padded to a group.
+                // the group then holds the tail's output and raw keystream past it, so it is wiped
+                if (length > 64 && static_cast<uint32_t>(counter) <= UINT32_MAX - 8) {
+                    uint8_t group[512] = {};
+                    std::memcpy(group, in, length);
+                    detail::blocks<Rounds>(group, group, 1, state, static_cast<uint32_t>(counter), static_cast<uint32_t>(counter >> 32));
+                    std::memcpy(out, group, length);
+                    secure_wipe(group, sizeof(group));
+                    return;
+                }
+                if (length) xor_scalar(out, in, length, counter * 64);
+            }
+
+            uint32_t state[16] = {};
+
+        private:
+            void xor_scalar(uint8_t* out, const uint8_t* in, size_t length, uint64_t offset) const {
+                if (out != in) std::memcpy(out, in, length);
+                transform(out, length, offset);
+            }
+        };
+
+        using arx = arx_stream<>;
+    }
+
+} // namespace cloakwork
+
+CW_POP_WARNINGS
+
+#endif // CLOAKWORK_KEYSTREAM_H
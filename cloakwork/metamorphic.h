@@ -0,0 +1,321 @@
+#ifndef CLOAKWORK_METAMORPHIC_H
+#define CLOAKWORK_METAMORPHIC_H
+
+// cloakwork/metamorphic.h - metamorphic functions and compile-time generated variants
+
+#include "value.h"
+#include "control_flow.h"
+
+#include <algorithm>
+#include <chrono>
+#include <initializer_list>
+
+CW_PUSH_WARNINGS
+
+namespace cloakwork {
+
+    // =================================================================
+    // metamorphic code generation
+    // =================================================================
+
+#if CW_ENABLE_METAMORPHIC
+    namespace metamorphic {
+
+        // dispatches each call to one of several equivalent implementations
+        // the active variant is chosen per thread and re-rolled every RotationPeriod calls,
+        // so the hot path is a thread-local countdown and one (well-predicted) indirect call
+        // with no shared writes. pointers are stored xor-keyed.
+        template<typename Func, size_t MaxMutations = 5, uint32_t RotationPeriod = 64>
+        class metamorphic_function {
+        private:
+            static_assert(MaxMutations > 0, "MaxMutations must be at least 1");
+            static_assert(RotationPeriod > 0, "RotationPeriod must be at least 1");
+
+            struct mutation {
+                uintptr_t encoded;
+                uintptr_t key;
+            };
+
+            mutation mutations[MaxMutations];
+
+            struct thread_selection {
+                uint32_t calls_left = 0;
+                size_t current = 0;
+            };
+
+        public:
+            static constexpr size_t MAX_MUTATIONS = MaxMutations;
+
+            metamorphic_function(Func* const* funcs, size_t count) {
+                count = std::min(count, MaxMutations);
+
+                // fill unused slots cyclically so every variant is picked equally often
+                for(size_t i = 0; i < MaxMutations; ++i) {
+                    Func* func = count ? funcs[i % count] : nullptr;
+                    mutations[i].key = static_cast<uintptr_t>(CW_RANDOM_RT());
+                    mutations[i].encoded = std::bit_cast<uintptr_t>(func) ^ mutations[i].key;
+                }
+            }
+
+            metamorphic_function(std::initializer_list<Func*> funcs)
+                : metamorphic_function(funcs.begin(), funcs.size()) {}
+
+            template<typename... Args>
+            CW_FORCEINLINE auto operator()(Args&&... args) const {
+                thread_local thread_selection selection;
+
+                if(selection.calls_left-- == 0) {
+                    selection.calls_left = RotationPeriod - 1;
+                    selection.current = static_cast<size_t>(CW_RANDOM_RT() % MaxMutations);
+                }
+
+                const mutation& m = mutations[selection.current];
+                Func* func = std::bit_cast<Func*>(m.encoded ^ m.key);
+                return func(std::forward<Args>(args)...);
+            }
+        };
+
+        // compile-time variant generation
+        // generated_variant<Fn, I> is a separate noinline instantiation of Fn wrapped in one of
+        // four transformation kinds (I % 4), seeded by I:
+        //   0 - plain forwarding call
+        //   1 - integral arguments round-tripped through keyed MBA add/sub
+        //   2 - call behind an opaque predicate; the never-taken decoy path calls Fn with every
+        //       integral argument offset by a seed-derived odd constant
+        //   3 - register-only junk chain; its result is an opaque zero added to every integral
+        //       argument (or pinned with a volatile sink when there are none), so it stays in
+        //       the code. the chain's length and rotations follow Variant, not just the kind
+        // kinds are numbered in order of expected cost, which is the static ranking.
+        // Fn must be a constant function pointer with linkage (a free function, or a namespace-scope
+        // constexpr captureless lambda converted with +).
+        inline constexpr size_t VARIANT_KINDS = 4;
+
+        template<uint64_t Key, typename A>
+        CW_FORCEINLINE decltype(auto) mba_roundtrip(A&& arg) {
+            using U = std::remove_cvref_t<A>;
+            if constexpr (std::is_integral_v<U> && !std::is_same_v<U, bool> && !std::is_lvalue_reference_v<A>) {
+                using W = std::make_unsigned_t<U>;
+                constexpr W k = static_cast<W>(Key);
+                W x = static_cast<W>(arg);
+
+                // MBA identity: x + k = (x ^ k) + 2 * (x & k)
+                x = static_cast<W>((x ^ k) + static_cast<W>((x & k) << 1));
+                CW_REGISTER_BARRIER(x);
+
+                // MBA identity: x - k = (x ^ k) - 2 * (~x & k)
+                x = static_cast<W>((x ^ k) - static_cast<W>((~x & k) << 1));
+                return static_cast<U>(x);
+            } else {
+                return std::forward<A>(arg);
+            }
+        }
+
+        // one step of the kind-3 junk chain
+        template<size_t Variant>
+        constexpr uint64_t junk_step(uint64_t junk, size_t round) {
+            return std::rotl(junk, static_cast<int>((Variant + round * 7) % 63) + 1) ^ (junk * (2 * round + 3));
+        }
+
+        template<typename A>
+        inline constexpr bool junk_mixable = std::is_integral_v<std::remove_cvref_t<A>> &&
+            !std::is_same_v<std::remove_cvref_t<A>, bool> && !std::is_lvalue_reference_v<A>;
+
+        // adds delta to an integral argument: the opaque zero of kind 3, the decoy offset of kind 2
+        template<typename A>
+        CW_FORCEINLINE decltype(auto) junk_mix(uint64_t delta, A&& arg) {
+            if constexpr (junk_mixable<A>) {
+                using U = std::remove_cvref_t<A>;
+                using W = std::make_unsigned_t<U>;
+                return static_cast<U>(static_cast<W>(static_cast<W>(arg) + static_cast<W>(delta)));
+            } else {
+                return std::forward<A>(arg);
+            }
+        }
+
+        // keeps a value that nothing else reads
+#if defined(__GNUC__) || defined(__clang__)
+        CW_FORCEINLINE void keep_register(uint64_t v) {
+            asm volatile("" : : "r"(v));
+        }
+#else
+        CW_FORCEINLINE void keep_register(uint64_t v) {
+            volatile uint64_t sink = v;
+            (void)sink;
+        }
+#endif
+
+        template<auto Fn, size_t Variant, typename Sig = std::remove_pointer_t<decltype(Fn)>>
+        struct generated_variant;
+
+        template<auto Fn, size_t Variant, typename R, typename... Args>
+        struct generated_variant<Fn, Variant, R(Args...)> {
+            static constexpr size_t kind = Variant % VARIANT_KINDS;
+            static constexpr uint64_t seed = (Variant + 1) * 0x9E3779B97F4A7C15ULL;
+
+            static CW_NOINLINE R call(Args... args) {
+                if constexpr (kind == 1) {
+                    return Fn(mba_roundtrip<seed>(std::forward<Args>(args))...);
+                } else if constexpr (kind == 2) {
+                    if (control_flow::opaque_true<static_cast<int>(Variant % 100) + 1>()) {
+                        return Fn(std::forward<Args>(args)...);
+                    }
+                    constexpr uint64_t decoy_offset = ~seed | 1;    // odd, so non-zero at every width
+                    return Fn(junk_mix(decoy_offset, std::forward<Args>(args))...);
+                } else if constexpr (kind == 3) {
+                    constexpr size_t rounds = 1 + (Variant / VARIANT_KINDS) % 4;
+                    constexpr uint64_t expected = [] {
+                        uint64_t j = seed;
+                        for (size_t r = 0; r < rounds; ++r) j = junk_step<Variant>(j, r);
+                        return j;
+                    }();
+
+                    uint64_t junk = seed;
+                    for (size_t r = 0; r < rounds; ++r) {
+                        CW_REGISTER_BARRIER(junk);
+                        junk = junk_step<Variant>(junk, r);
+                    }
+                    CW_REGISTER_BARRIER(junk);
+                    const uint64_t zero = junk ^ expected;
+
+                    if constexpr ((junk_mixable<Args> || ...)) {
+                        return Fn(junk_mix(zero, std::forward<Args>(args))...);
+                    } else {
+                        keep_register(zero);
+                        return Fn(std::forward<Args>(args)...);
+                    }
+                } else {
+                    return Fn(std::forward<Args>(args)...);
+                }
+            }
+        };
+
+        // the full set of N variants, with static and measured rankings
+        template<auto Fn, size_t N, typename Sig = std::remove_pointer_t<decltype(Fn)>>
+        struct generated_variants;
+
+        template<auto Fn, size_t N, typename R, typename... Args>
+        struct generated_variants<Fn, N, R(Args...)> {
+            static_assert(N > 0, "at least one variant is required");
+
+            using signature = R(Args...);
+
+            struct ranked {
+                signature* func;
+                uint64_t nanoseconds;
+            };
+
+        private:
+            template<size_t... I>
+            static constexpr std::array<signature*, N> table(std::index_sequence<I...>) {
+                return { &generated_variant<Fn, I>::call... };
+            }
+
+        public:
+            // cheapest transformation kinds first
+            static constexpr std::array<signature*, N> by_static_cost() {
+                auto all = table(std::make_index_sequence<N>{});
+                std::array<signature*, N> out{};
+                size_t k = 0;
+                for (size_t kind = 0; kind < VARIANT_KINDS; ++kind) {
+                    for (size_t i = kind; i < N; i += VARIANT_KINDS) {
+                        out[k++] = all[i];
+                    }
+                }
+                return out;
+            }
+
+            // times every variant on the sample arguments and sorts by latency
+            // note: calls Fn iterations * N times - only use this on side-effect free functions
+            static std::array<ranked, N> measure(size_t iterations, Args... sample) {
+                auto funcs = by_static_cost();
+                std::array<ranked, N> result{};
+
+                for (size_t v = 0; v < N; ++v) {
+                    signature* func = funcs[v];
+                    CW_REGISTER_BARRIER(func);  // keep the calls opaque to the optimizer
+
+                    auto start = std::chrono::steady_clock::now();
+                    for (size_t i = 0; i < iterations; ++i) {
+                        func(sample...);
+                        CW_COMPILER_BARRIER();
+                    }
+                    auto elapsed = std::chrono::steady_clock::now() - start;
+
+                    result[v].func = funcs[v];
+                    result[v].nanoseconds = static_cast<uint64_t>(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+                }
+
+                std::stable_sort(result.begin(), result.end(),
+                    [](const ranked& a, const ranked& b) { return a.nanoseconds < b.nanoseconds; });
+                return result;
+            }
+
+            // dispatcher over the hot_count cheapest variants (static ranking)
+            template<uint32_t RotationPeriod = 64>
+            static metamorphic_function<signature, N, RotationPeriod> dispatcher(size_t hot_count = N) {
+                auto funcs = by_static_cost();
+                return metamorphic_function<signature, N, RotationPeriod>(funcs.data(), std::clamp<size_t>(hot_count, 1, N));
+            }
+
+            // dispatcher over the hot_count fastest variants of a measured ranking
+            template<uint32_t RotationPeriod = 64>
+            static metamorphic_function<signature, N, RotationPeriod> dispatcher(const std::array<ranked, N>& ranking, size_t hot_count = N) {
+                std::array<signature*, N> funcs{};
+                for (size_t i = 0; i < N; ++i) funcs[i] = ranking[i].func;
+                return metamorphic_function<signature, N, RotationPeriod>(funcs.data(), std::clamp<size_t>(hot_count, 1, N));
+            }
+        };
+    }
+#else
+    namespace metamorphic {
+        template<typename Func, size_t MaxMutations = 5, uint32_t RotationPeriod = 64>
+        class metamorphic_function {
+        private:
+            Func* func_ptr;
+        public:
+            static constexpr size_t MAX_MUTATIONS = MaxMutations;
+            metamorphic_function(Func* const* funcs, size_t count) : func_ptr(count ? funcs[0] : nullptr) {}
+            metamorphic_function(std::initializer_list<Func*> funcs) {
+                if(funcs.size() > 0) func_ptr = *funcs.begin();
+            }
+            template<typename... Args>
+            CW_FORCEINLINE auto operator()(Args&&... args) const {
+                return func_ptr(std::forward<Args>(args)...);
+            }
+        };
+
+        template<auto Fn, size_t N, typename Sig = std::remove_pointer_t<decltype(Fn)>>
+        struct generated_variants;
+
+        template<auto Fn, size_t N, typename R, typename... Args>
+        struct generated_variants<Fn, N, R(Args...)> {
+            using signature = R(Args...);
+            struct ranked { signature* func; uint64_t nanoseconds; };
+            static constexpr std::array<signature*, N> by_static_cost() {
+                std::array<signature*, N> out{};
+                out.fill(Fn);
+                return out;
+            }
+            static std::array<ranked, N> measure(size_t, Args...) {
+                std::array<ranked, N> out{};
+                out.fill(ranked{Fn, 0});
+                return out;
+            }
+            template<uint32_t RotationPeriod = 64>
+            static metamorphic_function<signature, N, RotationPeriod> dispatcher(size_t = N) {
+                return metamorphic_function<signature, N, RotationPeriod>({Fn});
+            }
+            template<uint32_t RotationPeriod = 64>
+            static metamorphic_function<signature, N, RotationPeriod> dispatcher(const std::array<ranked, N>&, size_t = N) {
+                return metamorphic_function<signature, N, RotationPeriod>({Fn});
+            }
+        };
+    }
+#endif
+
+} // namespace cloakwork
+
+CW_POP_WARNINGS
+
+#endif // CLOAKWORK_METAMORPHIC_H
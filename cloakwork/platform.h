@@ -0,0 +1,47 @@
+#ifndef CLOAKWORK_PLATFORM_H
+#define CLOAKWORK_PLATFORM_H
+
+// cloakwork/platform.h - operating system headers for the subsystems that talk to the os
+// (anti-debug, import hiding, syscalls, integrity, assets, the secret arena). core, string and
+// value code never include it, except string.h through secret_arena.h with CW_ENABLE_SECRET_ARENA=1.
+
+#ifdef _WIN32
+    #include <windows.h>
+    #include <intrin.h>
+    #include <winternl.h>
+    #include <tlhelp32.h>
+    #include <iphlpapi.h>
+    #pragma comment(lib, "iphlpapi.lib")
+
+    // full LDR_DATA_TABLE_ENTRY structure (winternl.h has incomplete definition, fuck those guys)
+    namespace cloakwork_internal {
+        struct CW_LDR_DATA_TABLE_ENTRY {
+            LIST_ENTRY InLoadOrderLinks;
+            LIST_ENTRY InMemoryOrderLinks;
+            LIST_ENTRY InInitializationOrderLinks;
+            PVOID DllBase;
+            PVOID EntryPoint;
+            ULONG SizeOfImage;
+            UNICODE_STRING FullDllName;
+            UNICODE_STRING BaseDllName;
+            ULONG Flags;
+            USHORT LoadCount;
+            USHORT TlsIndex;
+            union {
+                LIST_ENTRY HashLinks;
+                struct {
+                    PVOID SectionPointer;
+                    ULONG CheckSum;
+                };
+            };
+            union {
+                ULONG TimeDateStamp;
+                PVOID LoadedImports;
+            };
+            PVOID EntryPointActivationContext;
+            PVOID PatchInformation;
+        };
+    }
+#endif
+
+#endif // CLOAKWORK_PLATFORM_H
@@ -0,0 +1,158 @@
+#ifndef CLOAKWORK_REGISTRY_H
+#define CLOAKWORK_REGISTRY_H
+
+// cloakwork/registry.h - bulk operations over the registries of encrypted objects:
+// cloakwork::warmup() decrypts (or prefetches) everything enrolled, cloakwork::cooldown()
+// re-encrypts it, and cloakwork::reencrypt_all() re-seals every object that currently
+// holds plaintext, optionally under a polled idle policy. the registries themselves live in core.h;
+// CW_ENABLE_WARMUP makes every CW_STR / CW_STR_LAYERED / CW_WSTR / CW_STR_ARX site enroll
+// itself at static init, while the live list needs no option.
+
+#include "core.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+CW_PUSH_WARNINGS
+
+namespace cloakwork {
+
+    // =================================================================
+    // parallel warmup / cooldown
+    // =================================================================
+
+    namespace registry {
+
+        // tasks taken per claim. a string site costs tens of nanoseconds, so workers claim
+        // runs of them and only a large asset task is worth a claim of its own
+        inline constexpr size_t WARM_BATCH = 64;
+
+        inline std::vector<warm_task*> warm_snapshot() {
+            std::vector<warm_task*> tasks;
+            for (warm_task* t = warm_tasks.load(std::memory_order_acquire); t; t = t->next) tasks.push_back(t);
+            return tasks;
+        }
+
+        inline size_t warm_count() {
+            size_t n = 0;
+            for (warm_task* t = warm_tasks.load(std::memory_order_acquire); t; t = t->next) ++n;
+            return n;
+        }
+
+        // runs every enrolled task on `threads` threads (the caller is one of them).
+        // 0 picks hardware_concurrency, capped at 8 and at one thread per batch
+        inline size_t run_all(bool warm, unsigned threads) {
+            const std::vector<warm_task*> tasks = warm_snapshot();
+            if (tasks.empty()) return 0;
+
+            if (threads == 0) threads = std::min(std::max(std::thread::hardware_concurrency(), 1u), 8u);
+            const size_t batches = (tasks.size() + WARM_BATCH - 1) / WARM_BATCH;
+            if (threads > batches) threads = static_cast<unsigned>(batches);
+
+            std::atomic<size_t> next{0};
+            auto work = [&tasks, &next, warm] {
+                for (;;) {
+                    const size_t begin = next.fetch_add(WARM_BATCH, std::memory_order_relaxed);
+                    if (begin >= tasks.size()) return;
+                    const size_t end = std::min(begin + WARM_BATCH, tasks.size());
+                    for (size_t i = begin; i < end; ++i) tasks[i]->run(tasks[i]->context, warm);
+                }
+            };
+
+            std::vector<std::thread> workers;
+            workers.reserve(threads - 1);
+            for (unsigned i = 1; i < threads; ++i) workers.emplace_back(work);
+            work();
+            for (auto& w : workers) w.join();
+            return tasks.size();
+        }
+    }
+
+    // decrypts every enrolled object up front, so first use on a request path is the
+    // already-decrypted fast path. returns the number of tasks run
+    inline size_t warmup(unsigned threads = 0) {
+        return registry::run_all(true, threads);
+    }
+
+    // re-encrypts every enrolled object, e.g. before an idle period. no pointer returned by
+    // get() may be in use while it runs
+    inline size_t cooldown(unsigned threads = 0) {
+        return registry::run_all(false, threads);
+    }
+
+    // =================================================================
+    // bulk re-encryption
+    // =================================================================
+
+    // re-encrypts every live object that has been decrypted at least once. the function-local
+    // statics behind CW_STR otherwise keep their plaintext until exit. objects already
+    // encrypted cost one atomic load. no pointer returned by get() may be in use while it runs.
+    // returns the number of objects visited
+    inline size_t reencrypt_all() {
+        registry::live_guard guard;
+        size_t visited = 0;
+        for (registry::live_node* n = registry::live_objects.load(std::memory_order_acquire); n; n = n->next) {
+            n->reseal(n->owner);
+            ++visited;
+        }
+        return visited;
+    }
+
+    namespace registry {
+        inline size_t live_count() {
+            live_guard guard;
+            size_t n = 0;
+            for (live_node* p = live_objects.load(std::memory_order_acquire); p; p = p->next) ++n;
+            return n;
+        }
+
+        // opt-in idle policy, driven by the caller: poll() runs reencrypt_all() once no object
+        // has been decrypted for `idle`. call it only where no get() result is in use (an event
+        // loop between requests, a worker between jobs), as for reencrypt_all() itself. only the
+        // decrypt slow path counts as use, so a literal read constantly through the fast path
+        // is resealed once per idle period and decrypts again on its next get()
+        class idle_resealer {
+        public:
+            using clock = std::chrono::steady_clock;
+
+            explicit idle_resealer(std::chrono::milliseconds idle = std::chrono::milliseconds(1000))
+                : idle(idle),
+                  seen(decrypt_epoch.load(std::memory_order_relaxed)),
+                  sealed(seen - 1),         // forces one pass after the first quiet period
+                  quiet_since(clock::now()) {}
+
+            // true when this call ran a pass
+            bool poll() {
+                const uint64_t now_epoch = decrypt_epoch.load(std::memory_order_relaxed);
+                const clock::time_point now = clock::now();
+                if (now_epoch != seen) {
+                    seen = now_epoch;
+                    quiet_since = now;
+                    return false;
+                }
+                if (now_epoch == sealed || now - quiet_since < idle) return false;
+
+                reencrypt_all();
+                sealed = now_epoch;
+                ++pass_count;
+                return true;
+            }
+
+            size_t passes() const { return pass_count; }
+
+        private:
+            std::chrono::milliseconds idle;
+            uint64_t seen;
+            uint64_t sealed;
+            clock::time_point quiet_since;
+            size_t pass_count = 0;
+        };
+    }
+
+} // namespace cloakwork
+
+CW_POP_WARNINGS
+
+#endif // CLOAKWORK_REGISTRY_H
@@ -0,0 +1,316 @@
+#ifndef CLOAKWORK_SECRET_ARENA_H
+#define CLOAKWORK_SECRET_ARENA_H
+
+// cloakwork/secret_arena.h - a pool for decrypted material on pages that are locked in ram
+// (never written to swap) and left out of core dumps. pages are mapped in 64 KiB slabs and
+// carved into power-of-two slot classes, so an allocation is a free-list pop or a pointer bump
+// and only a new slab costs a syscall. with CW_ENABLE_SECRET_ARENA=1 the transient plaintext
+// buffers of the library (CW_STR_STACK, scattered_vector growth, encrypted_asset chunk
+// readers) are taken from it.
+
+#include "core.h"
+
+#include <new>
+
+#if defined(_WIN32)
+    #include "platform.h"
+#elif defined(__unix__) || defined(__APPLE__)
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
+CW_PUSH_WARNINGS
+
+namespace cloakwork {
+
+    // =================================================================
+    // locked secret memory
+    // =================================================================
+
+    namespace memory {
+
+        // pages straight from the os, locked and excluded from dumps. both are best effort:
+        // RLIMIT_MEMLOCK (or a working-set quota on windows) leaves the pages mapped but
+        // pageable, which `locked` reports. dump exclusion is MADV_DONTDUMP on linux and
+        // MADV_NOCORE on the bsds
+        struct page_region {
+            void* base = nullptr;
+            size_t size = 0;
+            bool locked = false;
+        };
+
+        inline size_t page_size() {
+#if defined(_WIN32)
+            static const size_t size = [] {
+                SYSTEM_INFO info;
+                GetSystemInfo(&info);
+                return static_cast<size_t>(info.dwPageSize);
+            }();
+            return size;
+#elif defined(__unix__) || defined(__APPLE__)
+            static const size_t size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+            return size;
+#else
+            return 4096;
+#endif
+        }
+
+        inline size_t page_round(size_t size) {
+            const size_t page = page_size();
+            return (size + page - 1) / page * page;
+        }
+
+        inline page_region map_locked(size_t size) {
+            page_region region;
+            size = page_round(size);
+#if defined(_WIN32)
+            void* p = VirtualAlloc(nullptr, size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+            if (!p) return region;
+            region = { p, size, VirtualLock(p, size) != 0 };
+#elif defined(__unix__) || defined(__APPLE__)
+            void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0);
+            if (p == MAP_FAILED) return region;
+    #if defined(MADV_DONTDUMP)
+            madvise(p, size, MADV_DONTDUMP);
+    #elif defined(MADV_NOCORE)
+            madvise(p, size, MADV_NOCORE);
+    #endif
+            region = { p, size, mlock(p, size) == 0 };
+#else
+            void* p = ::operator new(size, std::align_val_t(64), std::nothrow);
+            if (!p) return region;
+            std::memset(p, 0, size);
+            region = { p, size, false };
+#endif
+            return region;
+        }
+
+        // the caller wipes first; unmapping also drops the lock
+        inline void unmap_locked(void* base, size_t size) {
+#if defined(_WIN32)
+            (void)size;
+            VirtualFree(base, 0, MEM_RELEASE);
+#elif defined(__unix__) || defined(__APPLE__)
+            munmap(base, size);
+#else
+            (void)size;
+            ::operator delete(base, std::align_val_t(64));
+#endif
+        }
+
+        // pool allocator over locked pages
+        // requests up to MAX_SLOT bytes are served from per-class slabs of SLAB_BYTES: a
+        // freed slot is wiped and pushed on its class's free list, and an allocation pops it
+        // again (or bumps through the newest slab), both O(1) under a per-class spin lock.
+        // larger requests get locked pages of their own (64-byte aligned). slots come back zeroed,
+        // aligned to their size, and slabs are never returned to the os. like scatter_arena,
+        // deallocate() needs the size that was requested
+        class secret_arena {
+        public:
+            static constexpr size_t SLAB_BYTES = 64 * 1024;
+            static constexpr size_t MIN_SHIFT = 5;
+            static constexpr size_t MIN_SLOT = size_t(1) << MIN_SHIFT;
+            static constexpr size_t CLASS_COUNT = 8;  // 32 bytes to 4 KiB
+            static constexpr size_t MAX_SLOT = MIN_SLOT << (CLASS_COUNT - 1);
+
+            struct usage {
+                size_t mapped;      // bytes mapped for slabs and large blocks
+                size_t locked;      // of which mlock / VirtualLock succeeded
+                size_t in_use;      // slot (or page-rounded) bytes currently handed out
+            };
+
+            // constant-initialized and never destroyed, so objects with static storage can
+            // still release into it during exit
+            static secret_arena& instance() {
+                static constinit secret_arena arena;
+                return arena;
+            }
+
+            // throws std::bad_alloc when the os refuses more pages; 0 bytes gives nullptr
+            void* allocate(size_t size) {
+                if (size == 0) return nullptr;
+                if (size > MAX_SLOT) return allocate_large(size);
+
+                const size_t cls = class_index(size);
+                size_class& c = classes[cls];
+                uint8_t* slot;
+                {
+                    class_guard guard(c.lock);
+                    slot = c.free_head;
+                    if (slot) {
+                        std::memcpy(&c.free_head, slot, LINK_BYTES);
+                    } else {
+                        if (c.bump == c.bump_end && !refill(c)) throw std::bad_alloc();
+                        slot = c.bump;
+                        c.bump += slot_size(cls);
+                    }
+                    ++c.used;
+                }
+                // the free-list link was the only non-zero word
+                std::memset(slot, 0, LINK_BYTES);
+                return slot;
+            }
+
+            void deallocate(void* ptr, size_t size) {
+                if (!ptr) return;
+                if (size > MAX_SLOT) {
+                    secure_wipe(ptr, size);
+                    release_large(ptr, size);
+                    return;
+                }
+
+                const size_t cls = class_index(size);
+                uint8_t* slot = static_cast<uint8_t*>(ptr);
+                secure_wipe(slot, slot_size(cls));
+
+                size_class& c = classes[cls];
+                class_guard guard(c.lock);
+                std::memcpy(slot, &c.free_head, LINK_BYTES);
+                c.free_head = slot;
+                --c.used;
+            }
+
+            usage stats() {
+                usage u{ mapped.load(std::memory_order_relaxed), locked.load(std::memory_order_relaxed),
+                         large_in_use.load(std::memory_order_relaxed) };
+                for (size_t cls = 0; cls < CLASS_COUNT; ++cls) {
+                    class_guard guard(classes[cls].lock);
+                    u.in_use += classes[cls].used * slot_size(cls);
+                }
+                return u;
+            }
+
+            static constexpr size_t slot_size(size_t cls) {
+                return MIN_SLOT << cls;
+            }
+
+            static constexpr size_t class_index(size_t size) {
+                return size <= MIN_SLOT ? 0 : static_cast<size_t>(std::bit_width(size - 1)) - MIN_SHIFT;
+            }
+
+        private:
+            // a free slot keeps the link to the next one in its first bytes
+            static constexpr size_t LINK_BYTES = sizeof(uint8_t*);
+
+            struct size_class {
+                std::atomic<bool> lock{false};
+                uint8_t* free_head = nullptr;
+                uint8_t* bump = nullptr;
+                uint8_t* bump_end = nullptr;
+                size_t used = 0;    // slots handed out
+            };
+
+            // held for a few instructions except while a slab is mapped, so waiters spin. a
+            // wait/notify lock would cost a notify on every release of the hot path
+            class class_guard {
+            public:
+                explicit class_guard(std::atomic<bool>& l) : l(l) {
+                    while (l.exchange(true, std::memory_order_acquire)) {
+                        while (l.load(std::memory_order_relaxed)) spin_pause();
+                    }
+                }
+                ~class_guard() {
+                    l.store(false, std::memory_order_release);
+                }
+                class_guard(const class_guard&) = delete;
+                class_guard& operator=(const class_guard&) = delete;
+
+            private:
+                std::atomic<bool>& l;
+            };
+
+            static CW_FORCEINLINE void spin_pause() {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+                _mm_pause();
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+                __builtin_ia32_pause();
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__)
+                asm volatile("yield");
+#endif
+            }
+
+            std::array<size_class, CLASS_COUNT> classes{};
+            std::atomic<size_t> mapped{0};
+            std::atomic<size_t> locked{0};
+            std::atomic<size_t> large_in_use{0};
+
+            constexpr secret_arena() = default;
+
+            void book(const page_region& region) {
+                mapped.fetch_add(region.size, std::memory_order_relaxed);
+                if (region.locked) locked.fetch_add(region.size, std::memory_order_relaxed);
+            }
+
+            bool refill(size_class& c) {
+                const page_region region = map_locked(SLAB_BYTES);
+                if (!region.base) return false;
+                book(region);
+                c.bump = static_cast<uint8_t*>(region.base);
+                c.bump_end = c.bump + SLAB_BYTES;
+                return true;
+            }
+
+            // large blocks are rare (an asset chunk buffer), so each keeps its own pages. a
+            // cache line in front of the block remembers whether the lock took
+            static constexpr size_t LARGE_HEADER = 64;
+
+            void* allocate_large(size_t size) {
+                const page_region region = map_locked(size + LARGE_HEADER);
+                if (!region.base) throw std::bad_alloc();
+                book(region);
+                large_in_use.fetch_add(region.size, std::memory_order_relaxed);
+                uint8_t* base = static_cast<uint8_t*>(region.base);
+                *base = region.locked ? 1 : 0;
+                return base + LARGE_HEADER;
+            }
+
+            void release_large(void* ptr, size_t size) {
+                uint8_t* base = static_cast<uint8_t*>(ptr) - LARGE_HEADER;
+                const size_t rounded = page_round(size + LARGE_HEADER);
+                if (*base) locked.fetch_sub(rounded, std::memory_order_relaxed);
+                mapped.fetch_sub(rounded, std::memory_order_relaxed);
+                large_in_use.fetch_sub(rounded, std::memory_order_relaxed);
+                unmap_locked(base, rounded);
+            }
+        };
+
+        // one owned arena allocation. move-only; the bytes are wiped when it is released
+        class secret_buffer {
+        public:
+            secret_buffer() = default;
+            explicit secret_buffer(size_t size)
+                : ptr(static_cast<uint8_t*>(secret_arena::instance().allocate(size))), length(size) {}
+
+            secret_buffer(const secret_buffer&) = delete;
+            secret_buffer& operator=(const secret_buffer&) = delete;
+
+            secret_buffer(secret_buffer&& other) noexcept
+                : ptr(std::exchange(other.ptr, nullptr)), length(std::exchange(other.length, 0)) {}
+
+            secret_buffer& operator=(secret_buffer&& other) noexcept {
+                if (this != &other) {
+                    secret_arena::instance().deallocate(ptr, length);
+                    ptr = std::exchange(other.ptr, nullptr);
+                    length = std::exchange(other.length, 0);
+                }
+                return *this;
+            }
+
+            ~secret_buffer() {
+                secret_arena::instance().deallocate(ptr, length);
+            }
+
+            uint8_t* data() const { return ptr; }
+            size_t size() const { return length; }
+
+        private:
+            uint8_t* ptr = nullptr;
+            size_t length = 0;
+        };
+    }
+
+} // namespace cloakwork
+
+CW_POP_WARNINGS
+
+#endif // CLOAKWORK_SECRET_ARENA_H
@@ -0,0 +1,715 @@
+#ifndef CLOAKWORK_STRING_H
+#define CLOAKWORK_STRING_H
+
+// cloakwork/string.h - compile-time string encryption (CW_STR, CW_STR_LAYERED, CW_WSTR, CW_STR_EQ,
+// CW_STR_ARX)
+
+#include "core.h"
+#include "keystream.h"
+
+#if CW_ENABLE_SECRET_ARENA
+    #include "secret_arena.h"
+#endif
+
+#include <mutex>
+#include <string_view>
+
+CW_PUSH_WARNINGS
+
+namespace cloakwork {
+
+    // =================================================================
+    // compile-time string encryption
+    // =================================================================
+
+#if CW_ENABLE_STRING_ENCRYPTION
+    namespace string_encrypt {
+
+        // out-of-line decoder bodies used when CW_SHARE_INSTANTIATIONS is set.
+        // the keys arrive as arguments, so every literal of a cipher shares one copy of the
+        // lock + loop instead of inlining its own; each literal keeps only the fast-path check.
+        // `target` is the state being entered (true = decrypt), the transforms mirror the
+        // constexpr encryptors in the classes below.
+        namespace shared {
+            CW_NOINLINE inline void xor_stream(std::atomic<bool>& state, std::mutex& mutex, bool target,
+                                               char* data, size_t n, uint8_t key1, uint8_t key2) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (state.load(std::memory_order_relaxed) == target) return;
+
+                for (size_t i = 0; i < n; ++i) {
+                    uint8_t k = static_cast<uint8_t>(key1 + i) ^ static_cast<uint8_t>(key2 - i * 3) ^
+                                static_cast<uint8_t>((i * i) ^ 0x5A);
+                    data[i] = static_cast<char>(static_cast<uint8_t>(data[i]) ^ k);
+                }
+                state.store(target, std::memory_order_release);
+            }
+
+            CW_NOINLINE inline void xor_stream_wide(std::atomic<bool>& state, std::mutex& mutex, bool target,
+                                                    wchar_t* data, size_t n, uint16_t key1, uint16_t key2) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (state.load(std::memory_order_relaxed) == target) return;
+
+                for (size_t i = 0; i < n; ++i) {
+                    wchar_t k1 = static_cast<wchar_t>(key1 + static_cast<uint16_t>(i));
+                    wchar_t k2 = static_cast<wchar_t>(key2 - static_cast<uint16_t>(i * 3));
+                    wchar_t k3 = static_cast<wchar_t>((i * i) ^ 0x5A5A);
+                    data[i] ^= k1 ^ k2 ^ k3;
+                }
+                state.store(target, std::memory_order_release);
+            }
+
+            CW_NOINLINE inline void layered(std::atomic<bool>& state, std::mutex& mutex, bool target,
+                                            char* data, size_t n, uint8_t key1, uint8_t key2, uint8_t key3) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (state.load(std::memory_order_relaxed) == target) return;
+
+                const char l1 = static_cast<char>(key1), l2 = static_cast<char>(key2), l3 = static_cast<char>(key3);
+                for (size_t i = 0; i < n; ++i) {
+                    char temp = data[i];
+                    const int rot = static_cast<int>((i % 7) + 1);
+                    if (target) {
+                        temp ^= static_cast<char>((i * i + i) ^ l3);
+                        temp ^= l2;
+                        temp = static_cast<char>(std::rotr(static_cast<uint8_t>(temp), rot));
+                        temp ^= (l1 + static_cast<char>(i));
+                    } else {
+                        temp ^= (l1 + static_cast<char>(i));
+                        temp = static_cast<char>(std::rotl(static_cast<uint8_t>(temp), rot));
+                        temp ^= l2;
+                        temp ^= static_cast<char>((i * i + i) ^ l3);
+                    }
+                    data[i] = temp;
+                }
+                state.store(target, std::memory_order_release);
+            }
+        }
+
+        template<size_t N, char Key1 = CW_RAND_CT(1, 127), char Key2 = CW_RAND_CT(1, 127)>
+        class encrypted_string {
+        private:
+            std::array<char, N> data;
+            mutable std::atomic<bool> decrypted{false};
+            mutable std::mutex mutex;
+            mutable registry::live_node live;
+
+            // compile-time keys (unique per build)
+            static constexpr uint8_t compile_key1 = static_cast<uint8_t>(Key1);
+            static constexpr uint8_t compile_key2 = static_cast<uint8_t>(Key2);
+
+            // position-dependent keystream byte (branch-free so loops over it vectorize)
+            static constexpr uint8_t keystream(size_t i) {
+                uint8_t k1 = static_cast<uint8_t>(compile_key1 + i);
+                uint8_t k2 = static_cast<uint8_t>(compile_key2 - i * 3);
+                uint8_t k3 = static_cast<uint8_t>((i * i) ^ 0x5A);
+                return k1 ^ k2 ^ k3;
+            }
+
+            // compile-time encryption (constexpr allows both compile-time and runtime use)
+            static constexpr char encrypt_char(char c, size_t i) {
+                return static_cast<char>(static_cast<uint8_t>(c) ^ keystream(i));
+            }
+
+            CW_FORCEINLINE void decrypt_impl() const {
+                if(!decrypted.load(std::memory_order_acquire)) {
+#if CW_SHARE_INSTANTIATIONS
+                    shared::xor_stream(decrypted, mutex, true, const_cast<char*>(data.data()), N, compile_key1, compile_key2);
+#else
+                    std::lock_guard<std::mutex> lock(mutex);
+
+                    // double-check after acquiring lock
+                    if (!decrypted.load(std::memory_order_relaxed)) {
+                        auto& mutable_data = const_cast<std::array<char, N>&>(data);
+
+                        for(size_t i = 0; i < N; ++i) {
+                            // reverse compile-time encryption (XOR is self-inverse)
+                            mutable_data[i] = encrypt_char(mutable_data[i], i);
+                        }
+                        decrypted.store(true, std::memory_order_release);
+                    }
+#endif
+                    registry::note_decrypt(live, this, &reseal);
+                }
+            }
+
+            // reencrypt_all() entry point
+            static void reseal(const void* self) {
+                static_cast<const encrypted_string*>(self)->encrypt_impl();
+            }
+
+            CW_FORCEINLINE void encrypt_impl() const {
+                if(decrypted.load(std::memory_order_acquire)) {
+#if CW_SHARE_INSTANTIATIONS
+                    shared::xor_stream(decrypted, mutex, false, const_cast<char*>(data.data()), N, compile_key1, compile_key2);
+#else
+                    std::lock_guard<std::mutex> lock(mutex);
+
+                    if (decrypted.load(std::memory_order_relaxed)) {
+                        auto& mutable_data = const_cast<std::array<char, N>&>(data);
+
+                        for(size_t i = 0; i < N; ++i) {
+                            // re-apply compile-time encryption (XOR is self-inverse)
+                            mutable_data[i] = encrypt_char(mutable_data[i], i);
+                        }
+                        decrypted.store(false, std::memory_order_release);
+                    }
+#endif
+                }
+            }
+
+        public:
+            template<size_t... I>
+            constexpr encrypted_string(const char (&str)[N], std::index_sequence<I...>)
+                : data{encrypt_char(str[I], I)...},
+                  decrypted(false) {}
+
+            constexpr encrypted_string(const char (&str)[N])
+                : encrypted_string(str, std::make_index_sequence<N>{}) {}
+
+            CW_FORCEINLINE const char* get() const {
+                decrypt_impl();
+                return data.data();
+            }
+
+            CW_FORCEINLINE operator const char*() const {
+                return get();
+            }
+
+            // constant-time comparison against the ciphertext
+            // the input is encrypted on the fly with the same keystream, so the stored
+            // literal is never decrypted. the loop has no data-dependent exits and the
+            // accumulator is branch-free, which lets the compiler vectorize it.
+            // only the length (already visible from the ciphertext size) is compared early.
+            CW_FORCEINLINE bool equals(std::string_view input) const {
+                if (input.size() != N - 1) return false;
+
+                std::lock_guard<std::mutex> lock(mutex);
+
+                // if a get() already decrypted the storage, compare without the keystream
+                const uint8_t mask = decrypted.load(std::memory_order_relaxed) ? 0x00 : 0xFF;
+                const uint8_t* in = reinterpret_cast<const uint8_t*>(input.data());
+                const uint8_t* ct = reinterpret_cast<const uint8_t*>(data.data());
+
+                uint8_t diff = 0;
+                for (size_t i = 0; i < N - 1; ++i) {
+                    diff |= static_cast<uint8_t>(in[i] ^ (keystream(i) & mask) ^ ct[i]);
+                }
+                CW_COMPILER_BARRIER();
+                return diff == 0;
+            }
+
+            // decrypts all N bytes into out straight from the ciphertext, the way equals()
+            // compares: the stored literal stays encrypted and is not listed for reseal
+            CW_FORCEINLINE void decrypt_to(char* out) const {
+                std::lock_guard<std::mutex> lock(mutex);
+                const uint8_t mask = decrypted.load(std::memory_order_relaxed) ? 0x00 : 0xFF;
+                const uint8_t* ct = reinterpret_cast<const uint8_t*>(data.data());
+                for (size_t i = 0; i < N; ++i) {
+                    out[i] = static_cast<char>(ct[i] ^ (keystream(i) & mask));
+                }
+            }
+
+            // back to ciphertext until the next get(); pointers from get() must not be in use
+            void reencrypt() const {
+                encrypt_impl();
+            }
+
+            // re-encrypt on destruction
+            ~encrypted_string() {
+                registry::unlist(live);
+                encrypt_impl();
+            }
+        };
+
+        template<size_t N>
+        encrypted_string(const char (&)[N]) -> encrypted_string<N>;
+
+        // constant-time compare of an encrypted literal with a runtime string
+        template<size_t N, char Key1, char Key2>
+        CW_FORCEINLINE bool equals(const encrypted_string<N, Key1, Key2>& enc, std::string_view input) {
+            return enc.equals(input);
+        }
+
+        // multi-layer encrypted string with polymorphic decryption
+        template<size_t N,
+                 uint8_t Layer1Key = CW_RAND_CT(1, 255),
+                 uint8_t Layer2Key = CW_RAND_CT(1, 255),
+                 uint8_t Layer3Key = CW_RAND_CT(1, 255)>
+        class layered_encrypted_string {
+        private:
+            std::array<char, N> data;
+            mutable std::atomic<bool> decrypted{false};
+            mutable std::atomic<uint32_t> access_count{0};
+            mutable std::mutex mutex;
+            mutable registry::live_node live;
+
+            static constexpr char encrypt_multilayer(char c, size_t i) {
+                // layer 1: position-dependent xor
+                char temp = c ^ (Layer1Key + static_cast<char>(i));
+
+                // layer 2: rotation + xor
+                temp = static_cast<char>(std::rotl(static_cast<uint8_t>(temp), static_cast<int>((i % 7) + 1)));
+                temp ^= Layer2Key;
+
+                // layer 3: polynomial mixing
+                temp ^= static_cast<char>((i * i + i) ^ Layer3Key);
+
+                return temp;
+            }
+
+            CW_FORCEINLINE void decrypt_impl() const {
+                if(!decrypted.load(std::memory_order_acquire)) {
+#if CW_SHARE_INSTANTIATIONS
+                    shared::layered(decrypted, mutex, true, const_cast<char*>(data.data()), N, Layer1Key, Layer2Key, Layer3Key);
+#else
+                    std::lock_guard<std::mutex> lock(mutex);
+
+                    if (!decrypted.load(std::memory_order_relaxed)) {
+                        auto& mutable_data = const_cast<std::array<char, N>&>(data);
+
+                        for(size_t i = 0; i < N; ++i) {
+                            char temp = mutable_data[i];
+
+                            // reverse layer 3
+                            temp ^= static_cast<char>((i * i + i) ^ Layer3Key);
+
+                            // reverse layer 2
+                            temp ^= Layer2Key;
+                            temp = static_cast<char>(std::rotr(static_cast<uint8_t>(temp), static_cast<int>((i % 7) + 1)));
+
+                            // reverse layer 1
+                            temp ^= (Layer1Key + static_cast<char>(i));
+
+                            mutable_data[i] = temp;
+                        }
+                        decrypted.store(true, std::memory_order_release);
+                    }
+#endif
+                    registry::note_decrypt(live, this, &reseal);
+                }
+            }
+
+            // reencrypt_all() entry point
+            static void reseal(const void* self) {
+                static_cast<const layered_encrypted_string*>(self)->encrypt_impl();
+            }
+
+            CW_FORCEINLINE void encrypt_impl() const {
+                if(decrypted.load(std::memory_order_acquire)) {
+#if CW_SHARE_INSTANTIATIONS
+                    shared::layered(decrypted, mutex, false, const_cast<char*>(data.data()), N, Layer1Key, Layer2Key, Layer3Key);
+#else
+                    std::lock_guard<std::mutex> lock(mutex);
+
+                    if (decrypted.load(std::memory_order_relaxed)) {
+                        auto& mutable_data = const_cast<std::array<char, N>&>(data);
+
+                        for(size_t i = 0; i < N; ++i) {
+                            mutable_data[i] = encrypt_multilayer(mutable_data[i], i);
+                        }
+                        decrypted.store(false, std::memory_order_release);
+                    }
+#endif
+                }
+            }
+
+            // polymorphic re-encryption on each access
+            CW_FORCEINLINE void morph() const {
+                uint32_t count = access_count.fetch_add(1, std::memory_order_relaxed);
+                if(count % 10 == 0 && decrypted.load(std::memory_order_acquire)) {
+                    encrypt_impl();
+                    decrypt_impl();
+                }
+            }
+
+        public:
+            template<size_t... I>
+            constexpr layered_encrypted_string(const char (&str)[N], std::index_sequence<I...>)
+                : data{encrypt_multilayer(str[I], I)...},
+                  decrypted(false) {}
+
+            constexpr layered_encrypted_string(const char (&str)[N])
+                : layered_encrypted_string(str, std::make_index_sequence<N>{}) {}
+
+            CW_FORCEINLINE const char* get() const {
+                decrypt_impl();
+                morph();
+                return data.data();
+            }
+
+            CW_FORCEINLINE operator const char*() const {
+                return get();
+            }
+
+            void reencrypt() const {
+                encrypt_impl();
+            }
+
+            ~layered_encrypted_string() {
+                registry::unlist(live);
+                encrypt_impl();
+            }
+        };
+
+        template<size_t N>
+        layered_encrypted_string(const char (&)[N]) -> layered_encrypted_string<N>;
+
+        // stack-based encrypted string that auto-clears on scope exit
+        template<size_t N>
+        class stack_encrypted_string {
+        private:
+#if CW_ENABLE_SECRET_ARENA
+            // a slot on locked, undumpable pages; the arena wipes it on release
+            memory::secret_buffer storage{N};
+
+            CW_FORCEINLINE char* buffer() const { return reinterpret_cast<char*>(storage.data()); }
+            CW_FORCEINLINE void clear_buffer() {}
+#else
+            char storage[N];
+
+            CW_FORCEINLINE const char* buffer() const { return storage; }
+            CW_FORCEINLINE char* buffer() { return storage; }
+
+            // overwritten with noise from a single rng call; the stores survive the
+            // buffer going out of scope
+            CW_FORCEINLINE void clear_buffer() {
+                secure_scramble(storage, N);
+            }
+#endif
+
+        public:
+            // decrypts into the buffer only; the source literal is never decrypted in place,
+            // so with the secret arena the plaintext exists on locked pages alone
+            template<char Key1, char Key2>
+            stack_encrypted_string(const encrypted_string<N, Key1, Key2>& enc) {
+                enc.decrypt_to(buffer());
+            }
+
+#if CW_ENABLE_SECRET_ARENA
+            // move-only: the slot has one owner
+            stack_encrypted_string(stack_encrypted_string&&) = default;
+#endif
+
+            const char* get() const { return buffer(); }
+            operator const char*() const { return buffer(); }
+
+            ~stack_encrypted_string() {
+                clear_buffer();
+            }
+        };
+
+        // wide string encryption
+        template<size_t N, wchar_t Key1 = static_cast<wchar_t>(CW_RAND_CT(1, 127)), wchar_t Key2 = static_cast<wchar_t>(CW_RAND_CT(1, 127))>
+        class encrypted_wstring {
+        private:
+            std::array<wchar_t, N> data;
+            mutable std::atomic<bool> decrypted{false};
+            mutable std::mutex mutex;
+            mutable registry::live_node live;
+
+            static constexpr uint16_t compile_key1 = static_cast<uint16_t>(Key1);
+            static constexpr uint16_t compile_key2 = static_cast<uint16_t>(Key2);
+
+            static constexpr wchar_t encrypt_char(wchar_t c, size_t i) {
+                wchar_t k1 = static_cast<wchar_t>(compile_key1 + static_cast<uint16_t>(i));
+                wchar_t k2 = static_cast<wchar_t>(compile_key2 - static_cast<uint16_t>(i * 3));
+                wchar_t k3 = static_cast<wchar_t>((i * i) ^ 0x5A5A);
+                return c ^ k1 ^ k2 ^ k3;
+            }
+
+            CW_FORCEINLINE void decrypt_impl() const {
+                if(!decrypted.load(std::memory_order_acquire)) {
+#if CW_SHARE_INSTANTIATIONS
+                    shared::xor_stream_wide(decrypted, mutex, true, const_cast<wchar_t*>(data.data()), N, compile_key1, compile_key2);
+#else
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (!decrypted.load(std::memory_order_relaxed)) {
+                        auto& mutable_data = const_cast<std::array<wchar_t, N>&>(data);
+                        for(size_t i = 0; i < N; ++i) {
+                            wchar_t k1 = static_cast<wchar_t>(compile_key1 + static_cast<uint16_t>(i));
+                            wchar_t k2 = static_cast<wchar_t>(compile_key2 - static_cast<uint16_t>(i * 3));
+                            wchar_t k3 = static_cast<wchar_t>((i * i) ^ 0x5A5A);
+                            mutable_data[i] ^= k1 ^ k2 ^ k3;
+                        }
+                        decrypted.store(true, std::memory_order_release);
+                    }
+#endif
+                    registry::note_decrypt(live, this, &reseal);
+                }
+            }
+
+            // reencrypt_all() entry point
+            static void reseal(const void* self) {
+                static_cast<const encrypted_wstring*>(self)->encrypt_impl();
+            }
+
+            CW_FORCEINLINE void encrypt_impl() const {
+                if(decrypted.load(std::memory_order_acquire)) {
+#if CW_SHARE_INSTANTIATIONS
+                    shared::xor_stream_wide(decrypted, mutex, false, const_cast<wchar_t*>(data.data()), N, compile_key1, compile_key2);
+#else
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (decrypted.load(std::memory_order_relaxed)) {
+                        auto& mutable_data = const_cast<std::array<wchar_t, N>&>(data);
+                        for(size_t i = 0; i < N; ++i) {
+                            wchar_t k1 = static_cast<wchar_t>(compile_key1 + static_cast<uint16_t>(i));
+                            wchar_t k2 = static_cast<wchar_t>(compile_key2 - static_cast<uint16_t>(i * 3));
+                            wchar_t k3 = static_cast<wchar_t>((i * i) ^ 0x5A5A);
+                            mutable_data[i] ^= k1 ^ k2 ^ k3;
+                        }
+                        decrypted.store(false, std::memory_order_release);
+                    }
+#endif
+                }
+            }
+
+        public:
+            template<size_t... I>
+            constexpr encrypted_wstring(const wchar_t (&str)[N], std::index_sequence<I...>)
+                : data{encrypt_char(str[I], I)...}, decrypted(false) {}
+
+            constexpr encrypted_wstring(const wchar_t (&str)[N])
+                : encrypted_wstring(str, std::make_index_sequence<N>{}) {}
+
+            CW_FORCEINLINE const wchar_t* get() const {
+                decrypt_impl();
+                return data.data();
+            }
+
+            CW_FORCEINLINE operator const wchar_t*() const { return get(); }
+
+            void reencrypt() const { encrypt_impl(); }
+
+            ~encrypted_wstring() {
+                registry::unlist(live);
+                encrypt_impl();
+            }
+        };
+
+        template<size_t N>
+        encrypted_wstring(const wchar_t (&)[N]) -> encrypted_wstring<N>;
+
+        // string under the arx counter-mode keystream (cloakwork/keystream.h). unlike the
+        // ciphers above the keystream never repeats, and any range decrypts on its own: read()
+        // copies out a slice of a long literal without decrypting the rest of it.
+        // the keys are template arguments so that every CW_STR_ARX site gets its own
+        template<size_t N, uint64_t K0, uint64_t K1, uint64_t K2, uint64_t K3, uint64_t Nonce>
+        class stream_string {
+        private:
+            std::array<char, N> data{};
+            mutable std::atomic<bool> decrypted{false};
+            mutable std::mutex mutex;
+            mutable registry::live_node live;
+
+            static constexpr stream::arx cipher{ K0, K1, K2, K3, Nonce };
+
+            CW_FORCEINLINE void crypt_impl(bool target) const {
+                if (decrypted.load(std::memory_order_acquire) != target) {
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        if (decrypted.load(std::memory_order_relaxed) != target) {
+                            char* mutable_data = const_cast<char*>(data.data());
+                            cipher.apply(mutable_data, mutable_data, N, 0);
+                            decrypted.store(target, std::memory_order_release);
+                        }
+                    }
+                    if (target) registry::note_decrypt(live, this, &reseal);
+                }
+            }
+
+            static void reseal(const void* self) {
+                static_cast<const stream_string*>(self)->crypt_impl(false);
+            }
+
+        public:
+            constexpr stream_string(const char (&str)[N]) {
+                for (size_t i = 0; i < N; ++i) data[i] = str[i];
+                cipher.transform(data.data(), N);
+            }
+
+            static constexpr size_t size() { return N - 1; }
+
+            CW_FORCEINLINE const char* get() const {
+                crypt_impl(true);
+                return data.data();
+            }
+
+            CW_FORCEINLINE operator const char*() const {
+                return get();
+            }
+
+            // copies chars [offset, offset + length) of the literal into dst, clamped to size().
+            // decrypts only that range (O(length)) and leaves the stored ciphertext untouched
+            size_t read(size_t offset, size_t length, char* dst) const {
+                if (offset >= N - 1) return 0;
+                if (length > N - 1 - offset) length = N - 1 - offset;
+
+                std::lock_guard<std::mutex> lock(mutex);
+                if (decrypted.load(std::memory_order_relaxed)) {
+                    std::memcpy(dst, data.data() + offset, length);
+                } else {
+                    cipher.apply(dst, data.data() + offset, length, offset);
+                }
+                return length;
+            }
+
+            char at(size_t index) const {
+                char c = 0;
+                read(index, 1, &c);
+                return c;
+            }
+
+            // constant-time comparison, one keystream block per 64 chars; the stored literal is
+            // never decrypted (see encrypted_string::equals)
+            bool equals(std::string_view input) const {
+                if (input.size() != N - 1) return false;
+
+                std::lock_guard<std::mutex> lock(mutex);
+                const uint8_t mask = decrypted.load(std::memory_order_relaxed) ? 0x00 : 0xFF;
+                const uint8_t* in = reinterpret_cast<const uint8_t*>(input.data());
+                const uint8_t* ct = reinterpret_cast<const uint8_t*>(data.data());
+
+                uint8_t diff = 0;
+                uint32_t ks[16];
+                for (size_t i = 0; i < N - 1; ++i) {
+                    if (i % 64 == 0) cipher.block(i / 64, ks);
+                    const uint8_t k = static_cast<uint8_t>(ks[(i % 64) / 4] >> (8 * (i % 4)));
+                    diff |= static_cast<uint8_t>(in[i] ^ (k & mask) ^ ct[i]);
+                }
+                // the last keystream block xored with the stored bytes is the literal's tail
+                secure_wipe(ks, sizeof(ks));
+                CW_COMPILER_BARRIER();
+                return diff == 0;
+            }
+
+            void reencrypt() const {
+                crypt_impl(false);
+            }
+
+            ~stream_string() {
+                registry::unlist(live);
+                crypt_impl(false);
+            }
+        };
+    }
+
+    // macro for easy string encryption with immediate re-encryption
+    namespace string_encrypt {
+        // storage picked by protection level (layered for strong)
+        template<typename Level, size_t N>
+        using level_string = std::conditional_t<level_traits<Level>::string_layered,
+            layered_encrypted_string<N>, encrypted_string<N>>;
+    }
+
+// string encryption at an explicit protection level
+#define CW_STR_P(s, lvl) \
+    static_cast<const char*>(([]() -> const char* { \
+        CW_PROFILE_PROBE("CW_STR"); \
+        using cw_level = CW_LEVEL_TYPE(lvl); \
+        static cloakwork::string_encrypt::level_string<cw_level, sizeof(s)> enc(s); \
+        CW_WARMUP_SITE(enc); \
+        if constexpr (cloakwork::level_traits<cw_level>::string_jitter) { \
+            int dummy = static_cast<int>(CW_RANDOM_RT() & 1); \
+            CW_COMPILER_BARRIER(); \
+            if (dummy < 0) return nullptr; \
+        } \
+        return enc.get(); \
+    }()))
+
+#define CW_STR(s) CW_STR_P(s, CW_DEFAULT_LEVEL)
+
+// constant-time compare of a runtime string against an encrypted literal
+// (the literal stays encrypted - no plaintext is ever written back to the static)
+#define CW_STR_EQ(input, s) \
+    ([](std::string_view cw_input) -> bool { \
+        static cloakwork::string_encrypt::encrypted_string<sizeof(s)> enc(s); \
+        return cloakwork::string_encrypt::equals(enc, cw_input); \
+    }(input))
+
+// layered encryption macro
+#define CW_STR_LAYERED(s) \
+    static_cast<const char*>(([]() -> const char* { \
+        static cloakwork::string_encrypt::layered_encrypted_string<sizeof(s)> enc(s); \
+        CW_WARMUP_SITE(enc); \
+        int dummy = static_cast<int>(CW_RANDOM_RT() & 1); \
+        CW_COMPILER_BARRIER(); \
+        return dummy >= 0 ? enc.get() : nullptr; \
+    }()))
+
+// stack-based encrypted string with tight scope control
+#define CW_STR_STACK(s) \
+    ([&]() { \
+        static cloakwork::string_encrypt::encrypted_string<sizeof(s)> enc(s); \
+        return cloakwork::string_encrypt::stack_encrypted_string<sizeof(s)>(enc); \
+    }())
+
+// wide string encryption macro
+#define CW_WSTR(s) \
+    static_cast<const wchar_t*>(([]() -> const wchar_t* { \
+        static cloakwork::string_encrypt::encrypted_wstring<sizeof(s)/sizeof(wchar_t)> enc(s); \
+        CW_WARMUP_SITE(enc); \
+        int dummy = static_cast<int>(CW_RANDOM_RT() & 1); \
+        CW_COMPILER_BARRIER(); \
+        return dummy >= 0 ? enc.get() : nullptr; \
+    }()))
+
+// counter-mode (arx) string encryption. CW_STR_ARX gives the decrypted literal like CW_STR;
+// the static is constinit, so a literal too long to encrypt at compile time is a build error
+// CW_STR_STREAM gives the encrypted object itself, for range reads of long literals:
+//   char buf[64];
+//   CW_STR_STREAM(long_text).read(4096, sizeof(buf), buf);
+#define CW_STR_STREAM(s) \
+    (*([]() { \
+        static constinit cloakwork::string_encrypt::stream_string<sizeof(s), CW_RANDOM_CT64(), CW_RANDOM_CT64(), \
+            CW_RANDOM_CT64(), CW_RANDOM_CT64(), CW_RANDOM_CT64()> enc(s); \
+        CW_WARMUP_SITE(enc); \
+        return &enc; \
+    }()))
+
+#define CW_STR_ARX(s) static_cast<const char*>(CW_STR_STREAM(s).get())
+
+#else
+    // no-op when string encryption is disabled
+    namespace string_encrypt {
+        // stand-in for stream_string over the plain literal
+        class plain_stream_string {
+        public:
+            constexpr plain_stream_string(std::string_view text) : text(text) {}
+
+            constexpr size_t size() const { return text.size(); }
+            constexpr const char* get() const { return text.data(); }
+            constexpr operator const char*() const { return get(); }
+
+            size_t read(size_t offset, size_t length, char* dst) const {
+                if (offset >= text.size()) return 0;
+                if (length > text.size() - offset) length = text.size() - offset;
+                std::memcpy(dst, text.data() + offset, length);
+                return length;
+            }
+
+            char at(size_t index) const { return index < text.size() ? text[index] : '\0'; }
+            bool equals(std::string_view input) const { return input == text; }
+
+        private:
+            std::string_view text;
+        };
+    }
+
+    #define CW_STR(s) (s)
+    #define CW_STR_P(s, lvl) (s)
+    #define CW_STR_EQ(input, s) (std::string_view(input) == std::string_view(s))
+    #define CW_STR_LAYERED(s) (s)
+    #define CW_STR_STACK(s) (s)
+    #define CW_WSTR(s) (s)
+    #define CW_STR_ARX(s) (s)
+    #define CW_STR_STREAM(s) \
+        (*([]() { \
+            static constexpr cloakwork::string_encrypt::plain_stream_string enc(s); \
+            return &enc; \
+        }()))
+#endif
+
+} // namespace cloakwork
+
+CW_POP_WARNINGS
+
+#endif // CLOAKWORK_STRING_H
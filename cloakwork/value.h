@@ -0,0 +1,613 @@
+#ifndef CLOAKWORK_VALUE_H
+#define CLOAKWORK_VALUE_H
+
+// cloakwork/value.h - value obfuscation: mba, obfuscated values and booleans, obfuscated
+// comparisons and encrypted constants (CW_INT, CW_MBA, CW_BOOL, CW_EQ, CW_CONST)
+
+#include "anti_debug.h"
+
+CW_PUSH_WARNINGS
+
+namespace cloakwork {
+
+    // =================================================================
+    // integer and data obfuscation with MBA (mixed boolean arithmetic)
+    // =================================================================
+
+#if CW_ENABLE_VALUE_OBFUSCATION
+
+    // mixed boolean arithmetic obfuscation
+    namespace mba {
+        // MBA identity: x + y = (x ^ y) + 2 * (x & y)
+        template<Integral T>
+        CW_FORCEINLINE constexpr T add_mba(T x, T y) {
+            return (x ^ y) + ((x & y) << 1);
+        }
+
+        // MBA identity: x - y = (x ^ y) - 2 * (~x & y)
+        template<Integral T>
+        CW_FORCEINLINE constexpr T sub_mba(T x, T y) {
+            return (x ^ y) - ((~x & y) << 1);
+        }
+
+        // MBA identity: x * 2 = (x ^ (x << 1)) + (x << 1)
+        template<Integral T>
+        CW_FORCEINLINE constexpr T mul2_mba(T x) {
+            return (x ^ (x << 1)) + (x << 1);
+        }
+
+        // MBA identity: -x = ~x + 1
+        template<Integral T>
+        CW_FORCEINLINE constexpr T neg_mba(T x) {
+            return add_mba(static_cast<T>(~x), static_cast<T>(1));
+        }
+
+        // MBA identity: x & y = ~(~x | ~y)
+        template<Integral T>
+        CW_FORCEINLINE constexpr T and_mba(T x, T y) {
+            return ~(~x | ~y);
+        }
+
+        // MBA identity: x | y = ~(~x & ~y)
+        template<Integral T>
+        CW_FORCEINLINE constexpr T or_mba(T x, T y) {
+            return ~(~x & ~y);
+        }
+    }
+
+    template<Arithmetic T, typename Level = level::standard>
+    class obfuscated_value {
+    private:
+        using traits = level_traits<Level>;
+
+        mutable T value{};
+        T xor_key{};
+        T add_key{};
+        mutable std::atomic<uint32_t> access_count{0};
+
+        // rotate bits for additional obfuscation
+        template<Integral U = T>
+        static constexpr U rotate_left(U val, int shift) {
+            constexpr int bits = sizeof(U) * 8;
+            shift %= bits;
+            return (val << shift) | (val >> (bits - shift));
+        }
+
+        template<Integral U = T>
+        static constexpr U rotate_right(U val, int shift) {
+            constexpr int bits = sizeof(U) * 8;
+            shift %= bits;
+            return (val >> shift) | (val << (bits - shift));
+        }
+
+    public:
+        obfuscated_value() {
+            xor_key = static_cast<T>(CW_RANDOM_RT());
+            add_key = static_cast<T>(CW_RANDOM_RT());
+            set(static_cast<T>(0));
+        }
+
+        obfuscated_value(T val) {
+            xor_key = static_cast<T>(CW_RANDOM_RT());
+            add_key = static_cast<T>(CW_RANDOM_RT());
+            set(val);
+        }
+
+        CW_FORCEINLINE void set(T val) {
+            if constexpr(traits::rekey_on_write) {
+                xor_key = static_cast<T>(CW_RANDOM_RT());
+                add_key = static_cast<T>(CW_RANDOM_RT());
+            }
+
+            if constexpr(Integral<T>) {
+                // multi-step obfuscation for integers using MBA + XOR
+                T temp = traits::value_mba ? mba::add_mba(val, add_key) : static_cast<T>(val + add_key);
+                value = temp ^ xor_key;
+            } else if constexpr(sizeof(T) == sizeof(uint64_t)) {
+                uint64_t bits = std::bit_cast<uint64_t>(val);
+                uint64_t key_bits = std::bit_cast<uint64_t>(xor_key);
+                bits ^= key_bits;
+                value = std::bit_cast<T>(bits);
+            } else if constexpr(sizeof(T) == sizeof(uint32_t)) {
+                uint32_t bits = std::bit_cast<uint32_t>(val);
+                uint32_t key_bits = std::bit_cast<uint32_t>(xor_key);
+                bits ^= key_bits;
+                value = std::bit_cast<T>(bits);
+            } else {
+                value = val;
+            }
+        }
+
+        CW_FORCEINLINE T get() const {
+            // inline anti-debug check every N accesses
+            if constexpr(traits::value_check_period != 0) {
+                if ((++access_count % traits::value_check_period) == 0) {
+                    CW_INLINE_CHECK();
+                }
+            }
+
+            if constexpr(Integral<T>) {
+                T temp = value ^ xor_key;
+                return traits::value_mba ? mba::sub_mba(temp, add_key) : static_cast<T>(temp - add_key);
+            } else if constexpr(sizeof(T) == sizeof(uint64_t)) {
+                uint64_t bits = std::bit_cast<uint64_t>(value);
+                uint64_t key_bits = std::bit_cast<uint64_t>(xor_key);
+                bits ^= key_bits;
+                return std::bit_cast<T>(bits);
+            } else if constexpr(sizeof(T) == sizeof(uint32_t)) {
+                uint32_t bits = std::bit_cast<uint32_t>(value);
+                uint32_t key_bits = std::bit_cast<uint32_t>(xor_key);
+                bits ^= key_bits;
+                return std::bit_cast<T>(bits);
+            } else {
+                return value;
+            }
+        }
+
+        CW_FORCEINLINE operator T() const { return get(); }
+        CW_FORCEINLINE obfuscated_value& operator=(T val) { set(val); return *this; }
+    };
+
+    // enhanced obfuscation using only MBA transformations
+    template<Integral T>
+    class mba_obfuscated {
+    private:
+        T encoded{};
+        T key1{};
+        T key2{};
+
+    public:
+        mba_obfuscated() {
+            key1 = static_cast<T>(CW_RANDOM_RT());
+            key2 = static_cast<T>(CW_RANDOM_RT());
+            set(static_cast<T>(0));
+        }
+
+        mba_obfuscated(T val) {
+            key1 = static_cast<T>(CW_RANDOM_RT());
+            key2 = static_cast<T>(CW_RANDOM_RT());
+            set(val);
+        }
+
+        CW_FORCEINLINE void set(T val) {
+            // encode using MBA: encoded = (val + key1) ^ key2
+            T temp = mba::add_mba(val, key1);
+            encoded = temp ^ key2;
+        }
+
+        CW_FORCEINLINE T get() const {
+            // decode using MBA: val = (encoded ^ key2) - key1
+            T temp = encoded ^ key2;
+            return mba::sub_mba(temp, key1);
+        }
+
+        CW_FORCEINLINE operator T() const { return get(); }
+        CW_FORCEINLINE mba_obfuscated& operator=(T val) { set(val); return *this; }
+    };
+
+    // =================================================================
+    // boolean obfuscation
+    // =================================================================
+
+    namespace bool_obfuscation {
+
+        // obfuscated true using multiple opaque predicates and runtime values
+        template<int N = CW_RAND_CT(1, 1000)>
+        CW_FORCEINLINE bool obfuscated_true() {
+            // runtime value prevents constant folding
+            volatile int runtime_val = static_cast<int>(reinterpret_cast<uintptr_t>(&runtime_val) & 0xFF);
+            int x = N + runtime_val;
+            CW_COMPILER_BARRIER();
+
+            // multiple always-true predicates combined
+            // property: product of consecutive integers is always even
+            bool result = ((x * (x + 1)) % 2) == 0;
+
+            // property: x OR x is always x
+            result = result && ((x | x) == x);
+
+            // property: x XOR 0 is always x
+            result = result && ((x ^ 0) == x);
+
+            // property: x AND x is always x
+            result = result && ((x & x) == x);
+
+            // MBA identity: ~(~x) == x
+            result = result && ((~(~x)) == x);
+
+            CW_COMPILER_BARRIER();
+            return result;
+        }
+
+        // obfuscated false using multiple opaque predicates
+        template<int N = CW_RAND_CT(1, 1000)>
+        CW_FORCEINLINE bool obfuscated_false() {
+            volatile int runtime_val = static_cast<int>(reinterpret_cast<uintptr_t>(&runtime_val) & 0xFF);
+            int x = N + runtime_val;
+            CW_COMPILER_BARRIER();
+
+            // multiple always-false predicates combined
+            // property: x AND (NOT x) is always 0
+            bool result = ((x & (~x)) != 0);
+
+            // property: x XOR x is always 0
+            result = result || ((x ^ x) != 0);
+
+            // property: impossible condition
+            result = result || (x * x < 0);
+
+            // MBA identity: (x - x) is always 0
+            result = result || (mba::sub_mba(x, x) != 0);
+
+            CW_COMPILER_BARRIER();
+            return result;
+        }
+
+        // obfuscate a boolean expression through indirection
+        template<int N = CW_RAND_CT(1, 1000)>
+        CW_FORCEINLINE bool obfuscate_bool(bool value) {
+            CW_COMPILER_BARRIER();
+
+            // transform: value = (value AND true) OR (false AND anything)
+            // mathematically equivalent to just 'value', but harder to analyze
+            bool true_val = obfuscated_true<N>();
+            bool false_val = obfuscated_false<N + 1>();
+
+            // multiple transformation layers
+            bool layer1 = value && true_val;
+            bool layer2 = false_val && (!value);
+            bool result = layer1 || layer2;
+
+            // additional confusion: XOR with known values
+            result = result ^ false_val;  // XOR with false doesn't change value
+
+            CW_COMPILER_BARRIER();
+            return result;
+        }
+
+        // class for storing obfuscated boolean values with anti-pattern storage
+        template<uint8_t Key1 = static_cast<uint8_t>(CW_RAND_CT(1, 255)),
+                 uint8_t Key2 = static_cast<uint8_t>(CW_RAND_CT(1, 255)),
+                 uint8_t Key3 = static_cast<uint8_t>(CW_RAND_CT(1, 255))>
+        class obfuscated_bool {
+        private:
+            mutable uint8_t encoded_primary;
+            mutable uint8_t encoded_secondary;
+            mutable uint8_t encoded_tertiary;
+            mutable std::atomic<uint32_t> access_count{0};
+
+            // distinct patterns for true/false that don't look like 0/1
+            static constexpr uint8_t TRUE_PATTERN = Key1 ^ 0xAA ^ Key2;
+            static constexpr uint8_t FALSE_PATTERN = Key1 ^ 0x55 ^ Key3;
+            static constexpr uint8_t VERIFY_MASK = Key2 ^ Key3;
+
+            CW_FORCEINLINE void encode(bool value) {
+                uint8_t runtime_noise = static_cast<uint8_t>(CW_RANDOM_RT() & 0xF0);
+
+                if (value) {
+                    // encode true across multiple bytes with different patterns
+                    encoded_primary = TRUE_PATTERN ^ runtime_noise;
+                    encoded_secondary = static_cast<uint8_t>(~encoded_primary) ^ Key1;
+                    encoded_tertiary = (encoded_primary + encoded_secondary) ^ VERIFY_MASK;
+                } else {
+                    // encode false with different patterns
+                    encoded_primary = FALSE_PATTERN ^ runtime_noise;
+                    encoded_secondary = static_cast<uint8_t>(~encoded_primary) ^ Key2;
+                    encoded_tertiary = (encoded_primary - encoded_secondary) ^ VERIFY_MASK;
+                }
+            }
+
+            CW_FORCEINLINE bool decode() const {
+                // decode using pattern matching, not simple comparison
+                // verify integrity through tertiary byte
+                uint8_t expected_true = (encoded_primary + (static_cast<uint8_t>(~encoded_primary) ^ Key1)) ^ VERIFY_MASK;
+                bool is_true_pattern = (encoded_tertiary == expected_true);
+
+                // use MBA to compute final result
+                int true_indicator = is_true_pattern ? 1 : 0;
+                int one = mba::sub_mba(2, 1);
+                return mba::sub_mba(true_indicator, 0) == one;
+            }
+
+        public:
+            obfuscated_bool() { encode(false); }
+            obfuscated_bool(bool value) { encode(value); }
+
+            CW_FORCEINLINE bool get() const {
+                // periodic anti-debug check
+                if ((++access_count % 500) == 0) {
+                    CW_INLINE_CHECK();
+                }
+
+                bool raw_value = decode();
+                // return through obfuscation layer
+                return obfuscate_bool(raw_value);
+            }
+
+            CW_FORCEINLINE void set(bool value) {
+                encode(value);
+            }
+
+            CW_FORCEINLINE operator bool() const { return get(); }
+            CW_FORCEINLINE obfuscated_bool& operator=(bool value) { set(value); return *this; }
+
+            // logical operators
+            CW_FORCEINLINE obfuscated_bool operator!() const {
+                return obfuscated_bool(!get());
+            }
+
+            CW_FORCEINLINE obfuscated_bool operator&&(bool other) const {
+                return obfuscated_bool(get() && other);
+            }
+
+            CW_FORCEINLINE obfuscated_bool operator||(bool other) const {
+                return obfuscated_bool(get() || other);
+            }
+        };
+    }
+
+    // convenience macros for boolean obfuscation
+    #define CW_TRUE (cloakwork::bool_obfuscation::obfuscated_true<CW_RAND_CT(1, 1000)>())
+    #define CW_FALSE (cloakwork::bool_obfuscation::obfuscated_false<CW_RAND_CT(1, 1000)>())
+    #define CW_BOOL(x) (cloakwork::bool_obfuscation::obfuscate_bool<CW_RAND_CT(1, 1000)>(x))
+
+    // convenience macros for MBA operations
+    #define CW_ADD(a, b) (cloakwork::mba::add_mba((a), (b)))
+    #define CW_SUB(a, b) (cloakwork::mba::sub_mba((a), (b)))
+    #define CW_AND(a, b) (cloakwork::mba::and_mba((a), (b)))
+    #define CW_OR(a, b) (cloakwork::mba::or_mba((a), (b)))
+
+#else
+    template<typename T, typename Level = level::standard>
+    class obfuscated_value {
+    private:
+        T value{};
+    public:
+        obfuscated_value() = default;
+        obfuscated_value(T val) : value(val) {}
+        CW_FORCEINLINE void set(T val) { value = val; }
+        CW_FORCEINLINE T get() const { return value; }
+        CW_FORCEINLINE operator T() const { return value; }
+        CW_FORCEINLINE obfuscated_value& operator=(T val) { value = val; return *this; }
+    };
+
+    template<typename T>
+    class mba_obfuscated {
+    private:
+        T value{};
+    public:
+        mba_obfuscated() = default;
+        mba_obfuscated(T val) : value(val) {}
+        CW_FORCEINLINE void set(T val) { value = val; }
+        CW_FORCEINLINE T get() const { return value; }
+        CW_FORCEINLINE operator T() const { return value; }
+        CW_FORCEINLINE mba_obfuscated& operator=(T val) { value = val; return *this; }
+    };
+
+    // plain arithmetic for code that uses mba:: unconditionally
+    namespace mba {
+        template<typename T> constexpr T add_mba(T x, T y) { return x + y; }
+        template<typename T> constexpr T sub_mba(T x, T y) { return x - y; }
+        template<typename T> constexpr T mul2_mba(T x) { return x * 2; }
+        template<typename T> constexpr T neg_mba(T x) { return -x; }
+        template<typename T> constexpr T and_mba(T x, T y) { return x & y; }
+        template<typename T> constexpr T or_mba(T x, T y) { return x | y; }
+    }
+
+    #define CW_ADD(a, b) ((a) + (b))
+    #define CW_SUB(a, b) ((a) - (b))
+    #define CW_AND(a, b) ((a) & (b))
+    #define CW_OR(a, b) ((a) | (b))
+
+    // no-op boolean obfuscation when disabled
+    namespace bool_obfuscation {
+        template<int N = 0> inline bool obfuscated_true() { return true; }
+        template<int N = 0> inline bool obfuscated_false() { return false; }
+        template<int N = 0> inline bool obfuscate_bool(bool value) { return value; }
+
+        class obfuscated_bool {
+        private:
+            bool value;
+        public:
+            obfuscated_bool() : value(false) {}
+            obfuscated_bool(bool val) : value(val) {}
+            CW_FORCEINLINE bool get() const { return value; }
+            CW_FORCEINLINE void set(bool val) { value = val; }
+            CW_FORCEINLINE operator bool() const { return value; }
+            CW_FORCEINLINE obfuscated_bool& operator=(bool val) { value = val; return *this; }
+            CW_FORCEINLINE obfuscated_bool operator!() const { return obfuscated_bool(!value); }
+            CW_FORCEINLINE obfuscated_bool operator&&(bool other) const { return obfuscated_bool(value && other); }
+            CW_FORCEINLINE obfuscated_bool operator||(bool other) const { return obfuscated_bool(value || other); }
+        };
+    }
+
+    #define CW_TRUE (true)
+    #define CW_FALSE (false)
+    #define CW_BOOL(x) (x)
+#endif
+
+    // =================================================================
+    // obfuscated comparisons
+    // =================================================================
+
+    namespace comparison {
+
+        // obfuscated equality check
+        template<typename T>
+        CW_FORCEINLINE bool obfuscated_equals(T a, T b) {
+            if constexpr (std::is_integral_v<T>) {
+                // (a == b) <=> ((a ^ b) == 0)
+                T diff = a ^ b;
+                // use MBA to check if zero
+                T zero_check = mba::sub_mba(diff, diff);
+                CW_COMPILER_BARRIER();
+                return zero_check == static_cast<T>(0) && diff == static_cast<T>(0);
+            } else {
+                return a == b;
+            }
+        }
+
+        // obfuscated not-equals check
+        template<typename T>
+        CW_FORCEINLINE bool obfuscated_not_equals(T a, T b) {
+            if constexpr (std::is_integral_v<T>) {
+                T diff = a ^ b;
+                CW_COMPILER_BARRIER();
+                return diff != static_cast<T>(0);
+            } else {
+                return a != b;
+            }
+        }
+
+        // obfuscated less-than check
+        template<typename T>
+        CW_FORCEINLINE bool obfuscated_less(T a, T b) {
+            if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+                // use subtraction and check sign bit
+                T diff = mba::sub_mba(a, b);
+                CW_COMPILER_BARRIER();
+                return diff < 0;
+            } else if constexpr (std::is_integral_v<T>) {
+                // unsigned comparison via subtraction with overflow check
+                CW_COMPILER_BARRIER();
+                return a < b;  // fall back for unsigned
+            } else {
+                return a < b;
+            }
+        }
+
+        // obfuscated greater-than check
+        template<typename T>
+        CW_FORCEINLINE bool obfuscated_greater(T a, T b) {
+            return obfuscated_less(b, a);
+        }
+
+        // obfuscated less-or-equal check
+        template<typename T>
+        CW_FORCEINLINE bool obfuscated_less_equal(T a, T b) {
+            return !obfuscated_greater(a, b);
+        }
+
+        // obfuscated greater-or-equal check
+        template<typename T>
+        CW_FORCEINLINE bool obfuscated_greater_equal(T a, T b) {
+            return !obfuscated_less(a, b);
+        }
+    }
+
+    #define CW_EQ(a, b) (cloakwork::comparison::obfuscated_equals((a), (b)))
+    #define CW_NE(a, b) (cloakwork::comparison::obfuscated_not_equals((a), (b)))
+    #define CW_LT(a, b) (cloakwork::comparison::obfuscated_less((a), (b)))
+    #define CW_GT(a, b) (cloakwork::comparison::obfuscated_greater((a), (b)))
+    #define CW_LE(a, b) (cloakwork::comparison::obfuscated_less_equal((a), (b)))
+    #define CW_GE(a, b) (cloakwork::comparison::obfuscated_greater_equal((a), (b)))
+
+    // =================================================================
+    // encrypted compile-time constants
+    // =================================================================
+
+    namespace constants {
+
+        // keys cover the full width of T. the encrypted value only ever lives in a register:
+        // CW_REGISTER_BARRIER stops constant folding without a volatile store/load, so a
+        // constant reused in a loop is decoded once and hoisted like any other invariant.
+        // the decoded value goes through a barrier too, or the final xor with the key would
+        // be re-associated into the caller's expression and stay inside the loop.
+        // MultiStep adds a rotate + MBA decode chain for the sites that need it.
+        template<typename T, T Value,
+                 uint64_t Key1 = CW_RANDOM_CT64(),
+                 uint64_t Key2 = CW_RANDOM_CT64(),
+                 bool MultiStep = false>
+        struct encrypted_constant {
+            static CW_FORCEINLINE T get() {
+                if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool>) {
+                    using U = std::make_unsigned_t<std::remove_cv_t<T>>;
+                    constexpr U k1 = static_cast<U>(Key1);
+                    constexpr U k2 = static_cast<U>(Key2);
+
+                    if constexpr (MultiStep) {
+                        // encode: rotl((value ^ k1) + k2, r)
+                        constexpr int r = static_cast<int>((Key2 >> 57) % (sizeof(U) * 8 - 1)) + 1;
+                        constexpr U encrypted = std::rotl(
+                            static_cast<U>(static_cast<U>(static_cast<U>(Value) ^ k1) + k2), r);
+
+                        U x = encrypted;
+                        CW_REGISTER_BARRIER(x);
+                        x = std::rotr(x, r);
+
+                        // MBA identity: x - y = (x ^ y) - 2 * (~x & y)
+                        x = static_cast<U>((x ^ k2) - static_cast<U>((~x & k2) << 1));
+                        CW_REGISTER_BARRIER(x);
+
+                        // MBA identity: x ^ y = (x | y) - (x & y)
+                        x = static_cast<U>((x | k1) - (x & k1));
+                        CW_REGISTER_BARRIER(x);
+                        return static_cast<T>(x);
+                    } else {
+                        constexpr U encrypted = static_cast<U>(static_cast<U>(Value) ^ k1);
+                        U x = encrypted;
+                        CW_REGISTER_BARRIER(x);
+                        x ^= k1;
+                        CW_REGISTER_BARRIER(x);
+                        return static_cast<T>(x);
+                    }
+                } else {
+                    return Value;
+                }
+            }
+        };
+
+        // runtime-keyed constant (different each execution)
+        template<typename T>
+        class runtime_constant {
+        private:
+            T encrypted;
+            T key;
+
+        public:
+            runtime_constant(T value) {
+                key = static_cast<T>(CW_RANDOM_RT());
+                if constexpr (std::is_integral_v<T>) {
+                    encrypted = value ^ key;
+                } else {
+                    encrypted = value;
+                }
+            }
+
+            CW_FORCEINLINE T get() const {
+                if constexpr (std::is_integral_v<T>) {
+                    T temp = encrypted;
+                    CW_REGISTER_BARRIER(temp);
+                    return temp ^ key;
+                } else {
+                    return encrypted;
+                }
+            }
+
+            CW_FORCEINLINE operator T() const { return get(); }
+        };
+    }
+
+    // keys are drawn per call site (a defaulted template key would be shared by every constant).
+    // cv is stripped so a named constexpr constant works: decltype gives `const int` there
+    #define CW_CONST(val) \
+        (cloakwork::constants::encrypted_constant<std::remove_cv_t<decltype(val)>, val, CW_RANDOM_CT64(), CW_RANDOM_CT64()>::get())
+
+    #define CW_CONST_MBA(val) \
+        (cloakwork::constants::encrypted_constant<std::remove_cv_t<decltype(val)>, val, CW_RANDOM_CT64(), CW_RANDOM_CT64(), true>::get())
+
+    #if CW_ENABLE_VALUE_OBFUSCATION
+        #define CW_INT_P(x, lvl) CW_PROFILE_WRAP("CW_INT", cloakwork::obfuscated_value<decltype(x), CW_LEVEL_TYPE(lvl)>{x})
+        #define CW_INT(x) CW_INT_P(x, CW_DEFAULT_LEVEL)
+        #define CW_MBA(x) CW_PROFILE_WRAP("CW_MBA", cloakwork::mba_obfuscated<decltype(x)>{x})
+    #else
+        #define CW_INT(x) (x)
+        #define CW_INT_P(x, lvl) (x)
+        #define CW_MBA(x) (x)
+    #endif
+
+} // namespace cloakwork
+
+CW_POP_WARNINGS
+
+#endif // CLOAKWORK_VALUE_H
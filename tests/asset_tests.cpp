@@ -0,0 +1,227 @@
+// encrypted assets and archives: pack / attach round-trips for every cipher, random range
+// reads, chunk streaming with verification, and the failure states of a damaged blob
+
+#include "test.h"
+#include "cloakwork.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+    namespace asset = cloakwork::asset;
+
+    std::vector<uint8_t> make_payload(size_t size, uint32_t seed) {
+        std::vector<uint8_t> data(size);
+        for (auto& b : data) {
+            seed = seed * 1664525u + 1013904223u;
+            b = static_cast<uint8_t>(seed >> 24);
+        }
+        return data;
+    }
+
+    constexpr asset::key128 KEY = CW_ASSET_KEY("cloakwork test passphrase");
+    constexpr asset::key128 OTHER_KEY = CW_ASSET_KEY("not the passphrase");
+}
+
+TEST_CASE(asset_round_trip) {
+    const uint16_t ciphers[] = { asset::CIPHER_CTR32, asset::CIPHER_ARX8, asset::CIPHER_ARX12, asset::CIPHER_ARX20 };
+    for (uint16_t cipher : ciphers) {
+        for (size_t size : { size_t(0), size_t(1), size_t(4096), size_t(100000) }) {
+            const auto plain = make_payload(size, static_cast<uint32_t>(size + cipher));
+            const auto blob = asset::pack(plain.data(), plain.size(), KEY, 4096, 0, cipher);
+            REQUIRE(blob.size() == asset::packed_size(size, 4096));
+
+            asset::encrypted_asset a(blob.data(), blob.size(), KEY);
+            REQUIRE(a.valid());
+            CHECK(a.size() == size);
+            CHECK(a.decrypt(true) == plain);
+
+            // the ciphertext does not contain the plaintext
+            if (size >= 4096) {
+                CHECK(std::search(blob.begin(), blob.end(), plain.begin(), plain.begin() + 64) == blob.end());
+            }
+
+            // random-access ranges, including ones across chunk boundaries
+            std::vector<uint8_t> range(5000);
+            bool ranges = true;
+            for (uint64_t offset = 0; offset < size; offset += 3001) {
+                const size_t n = a.read(offset, range.data(), range.size());
+                ranges &= n == std::min<size_t>(range.size(), size - offset);
+                ranges &= std::memcmp(range.data(), plain.data() + offset, n) == 0;
+            }
+            CHECK(ranges);
+
+            std::vector<uint8_t> streamed;
+            auto reader = a.chunks(true);
+            for (const auto& view : reader) streamed.insert(streamed.end(), view.begin(), view.end());
+            CHECK(!reader.failed());
+            CHECK(streamed == plain);
+        }
+    }
+}
+
+TEST_CASE(asset_failure_states) {
+    const auto plain = make_payload(10000, 7);
+    auto blob = asset::pack(plain.data(), plain.size(), KEY);
+
+    asset::encrypted_asset wrong(blob.data(), blob.size(), OTHER_KEY);
+    CHECK(!wrong.valid());
+    CHECK(wrong.error() == asset::status::wrong_key);
+    CHECK(wrong.decrypt().empty());
+    uint8_t byte = 0;
+    CHECK(wrong.read(0, &byte, 1) == 0);
+
+    asset::encrypted_asset truncated(blob.data(), blob.size() - 1, KEY);
+    CHECK(truncated.error() == asset::status::truncated);
+
+    asset::encrypted_asset tiny(blob.data(), 8, KEY);
+    CHECK(tiny.error() == asset::status::truncated);
+
+    asset::encrypted_asset none;
+    CHECK(none.error() == asset::status::empty);
+
+    // a moved-from asset is empty and reads nothing; the target owns the data
+    asset::encrypted_asset source(blob.data(), blob.size(), KEY);
+    REQUIRE(source.valid());
+    asset::encrypted_asset target(std::move(source));
+    CHECK(!source.valid());
+    CHECK(source.error() == asset::status::empty);
+    CHECK(source.size() == 0);
+    CHECK(source.read(0, &byte, 1) == 0);
+    CHECK(source.decrypt().empty());
+    CHECK(target.decrypt(true) == plain);
+    source = std::move(target);
+    CHECK(source.valid());
+    CHECK(target.error() == asset::status::empty);
+    CHECK(source.decrypt(true) == plain);
+
+    // a flipped ciphertext byte decrypts, but fails verification
+    blob.back() ^= 0x01;
+    asset::encrypted_asset damaged(blob.data(), blob.size(), KEY);
+    REQUIRE(damaged.valid());
+    CHECK(damaged.decrypt(false).size() == plain.size());
+    CHECK(damaged.decrypt(true).empty());
+
+    blob[0] ^= 0x01;
+    asset::encrypted_asset bad_magic(blob.data(), blob.size(), KEY);
+    CHECK(bad_magic.error() == asset::status::bad_magic);
+}
+
+TEST_CASE(asset_open_file) {
+    const auto plain = make_payload(70000, 11);
+    const auto blob = asset::pack(plain.data(), plain.size(), KEY);
+    const char* path = "cloakwork_tests_asset.bin";
+
+    std::FILE* f = std::fopen(path, "wb");
+    REQUIRE(f);
+    const bool written = std::fwrite(blob.data(), 1, blob.size(), f) == blob.size();
+    std::fclose(f);
+    REQUIRE(written);
+
+    {
+        auto a = asset::encrypted_asset::open(path, KEY);
+        CHECK(a.valid());
+        CHECK(a.decrypt(true) == plain);
+        auto missing = asset::encrypted_asset::open("cloakwork_tests_missing.bin", KEY);
+        CHECK(missing.error() == asset::status::open_failed);
+    }
+    std::remove(path);
+}
+
+TEST_CASE(archive_round_trip) {
+    std::vector<std::vector<uint8_t>> payloads;
+    std::vector<std::string> names;
+    asset::archive_builder builder;
+    for (size_t i = 0; i < 64; ++i) {
+        names.push_back("assets/file_" + std::to_string(i) + ".bin");
+        payloads.push_back(make_payload(i * 37, static_cast<uint32_t>(i)));
+    }
+    for (size_t i = 0; i < names.size(); ++i) {
+        CHECK(builder.add(names[i].c_str(), payloads[i].data(), payloads[i].size()));
+    }
+    CHECK(!builder.add(names[0].c_str(), payloads[0].data(), payloads[0].size()));
+    CHECK(builder.size() == names.size());
+
+    for (uint16_t cipher : { asset::CIPHER_CTR32, asset::CIPHER_ARX12 }) {
+        const auto blob = builder.build(KEY, 0, cipher);
+        asset::encrypted_archive archive(blob.data(), blob.size(), KEY);
+        REQUIRE(archive.valid());
+        CHECK(archive.size() == names.size());
+
+        bool found = true;
+        for (size_t i = 0; i < names.size(); ++i) {
+            const auto entry = archive.find(names[i].c_str());
+            found &= static_cast<bool>(entry);
+            found &= entry.size() == payloads[i].size();
+            found &= entry.decrypt(true) == payloads[i];
+        }
+        CHECK(found);
+
+        CHECK(!archive.find("assets/missing.bin"));
+        CHECK(!archive.contains(cloakwork::hash::fnv1a_runtime("assets/missing.bin")));
+        CHECK(archive.contains(cloakwork::hash::fnv1a_runtime(names[5].c_str())));
+
+        // iteration in hash order
+        bool ordered = true;
+        for (size_t i = 1; i < archive.size(); ++i) ordered &= archive.hash_at(i - 1) < archive.hash_at(i);
+        CHECK(ordered);
+        CHECK(!archive.entry_at(archive.size()));
+
+        const auto& big = payloads.back();
+        const auto entry = archive.find(names.back().c_str());
+        uint8_t tail[16];
+        CHECK(entry.read(big.size() - 10, tail, sizeof(tail)) == 10);
+        CHECK(std::memcmp(tail, big.data() + big.size() - 10, 10) == 0);
+    }
+}
+
+TEST_CASE(archive_failed_attach_lookups) {
+    const auto payload = make_payload(300, 3);
+    asset::archive_builder builder;
+    builder.add("config.json", payload.data(), payload.size());
+    builder.add("shaders/main.spv", payload.data(), 100);
+    auto blob = builder.build(KEY);
+
+    // the header parses but the key is wrong: nothing may be looked up
+    asset::encrypted_archive wrong(blob.data(), blob.size(), OTHER_KEY);
+    CHECK(wrong.error() == asset::status::wrong_key);
+    CHECK(wrong.size() == 0);
+    CHECK(!wrong.find("config.json"));
+    CHECK(!wrong.find(cloakwork::hash::fnv1a_runtime("config.json")));
+    CHECK(!wrong.contains(cloakwork::hash::fnv1a_runtime("shaders/main.spv")));
+    CHECK(!wrong.entry_at(0));
+    CHECK(wrong.hash_at(0) == 0);
+
+    asset::encrypted_archive truncated(blob.data(), blob.size() - 1, KEY);
+    CHECK(truncated.error() == asset::status::truncated);
+    CHECK(!truncated.find("config.json"));
+
+    asset::encrypted_archive none;
+    CHECK(!none.find("config.json"));
+    CHECK(!none.contains(0));
+
+    // a moved-from archive is empty and hands out no entries into the new owner's data
+    asset::encrypted_archive source(blob.data(), blob.size(), KEY);
+    REQUIRE(source.valid());
+    asset::encrypted_archive target(std::move(source));
+    CHECK(source.error() == asset::status::empty);
+    CHECK(source.size() == 0);
+    CHECK(!source.find("config.json"));
+    CHECK(!source.entry_at(0));
+    CHECK(target.size() == 2);
+    CHECK(target.find("config.json").decrypt(true) == payload);
+    source = std::move(target);
+    CHECK(source.valid());
+    CHECK(target.size() == 0);
+    CHECK(!target.find("config.json"));
+
+    // a corrupted header
+    blob[sizeof(uint32_t) * 3] ^= 0x01;
+    asset::encrypted_archive damaged(blob.data(), blob.size(), KEY);
+    CHECK(!damaged.valid());
+    CHECK(!damaged.find("config.json"));
+}
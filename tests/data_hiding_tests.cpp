@@ -0,0 +1,392 @@
+// data hiding: scattered_value / polymorphic_value round-trips and copies, the seqlock
+// under concurrent writers and readers, scattered_vector growth and scattered_map churn (also
+// of a type with no default constructor) against a std::unordered_map reference
+
+#include "test.h"
+#include "cloakwork.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+    struct record {
+        uint64_t id;
+        uint64_t check;     // ~id, so a torn read shows up
+        uint32_t level;
+        uint32_t pad;
+
+        bool consistent() const { return check == ~id && level == static_cast<uint32_t>(id * 3); }
+    };
+
+    record make_record(uint64_t id) {
+        return { id, ~id, static_cast<uint32_t>(id * 3), 0 };
+    }
+
+    // trivially copyable but not default-constructible
+    struct point {
+        int32_t x, y;
+        point(int32_t px, int32_t py) : x(px), y(py) {}
+    };
+}
+
+#if CW_ENABLE_DATA_HIDING
+TEST_CASE(scatter_arena_slots) {
+    // every slot is distinct, large requests bypass the slabs, and slots freed from slabs
+    // that empty out (and go back to the heap) do not disturb the ones still in use
+    auto& arena = cloakwork::data_hiding::scatter_arena::instance();
+    const size_t sizes[8] = { 1, 3, 8, 9, 64, 200, 256, 1000 };
+    struct batch {
+        uint8_t* slots[8];
+        uint8_t tag;
+    };
+
+    std::vector<batch> live;
+    auto fill = [&](uint8_t tag) {
+        batch b{ {}, tag };
+        arena.allocate(sizes, b.slots, 8);
+        for (size_t k = 0; k < 8; ++k) std::memset(b.slots[k], tag + k, sizes[k]);
+        live.push_back(b);
+    };
+    auto intact = [&] {
+        bool ok = true;
+        for (const batch& b : live) {
+            for (size_t k = 0; k < 8; ++k) {
+                for (size_t j = 0; j < sizes[k]; ++j) ok &= b.slots[k][j] == static_cast<uint8_t>(b.tag + k);
+            }
+        }
+        return ok;
+    };
+
+    for (size_t i = 0; i < 20000; ++i) fill(static_cast<uint8_t>(i * 13));
+    CHECK(intact());
+
+    // drop every other batch, then most of the rest
+    std::vector<batch> kept;
+    for (size_t i = 0; i < live.size(); ++i) {
+        if (i % 2 == 0 || i % 7 != 1) arena.deallocate(live[i].slots, sizes, 8);
+        else kept.push_back(live[i]);
+    }
+    live.swap(kept);
+    CHECK(intact());
+
+    for (size_t i = 0; i < 5000; ++i) fill(static_cast<uint8_t>(i * 29 + 5));
+    CHECK(intact());
+
+    for (batch& b : live) arena.deallocate(b.slots, sizes, 8);
+    live.clear();
+
+    CHECK(arena.allocate(0) == nullptr);
+    uint8_t* one = arena.allocate(1);
+    CHECK(one != nullptr);
+    arena.deallocate(one, 1);
+}
+#endif
+
+TEST_CASE(scattered_value_round_trip) {
+    using cloakwork::data_hiding::scattered_value;
+
+    scattered_value<int, 4> empty;
+    CHECK(empty.get() == 0);
+
+    scattered_value<int, 4> a(0x12345678);
+    CHECK(a.get() == 0x12345678);
+    a.set(-7);
+    CHECK(static_cast<int>(a) == -7);
+
+    scattered_value<record, 8> r(make_record(42));
+    CHECK(r.get().id == 42);
+    CHECK(r.get().consistent());
+
+    scattered_value<uint64_t, 2> two(0xDEADBEEFCAFEF00DULL);
+    CHECK(two.get() == 0xDEADBEEFCAFEF00DULL);
+
+    const uint64_t scatter = CW_SCATTER(uint64_t(1234567));
+    CHECK(scatter == 1234567);
+}
+
+TEST_CASE(scattered_value_copy) {
+    using cloakwork::data_hiding::scattered_value;
+
+    scattered_value<uint64_t> a(99);
+    scattered_value<uint64_t> b(a);
+    CHECK(b.get() == 99);
+    b.set(100);
+    CHECK(a.get() == 99);
+    CHECK(b.get() == 100);
+
+    a = b;
+    CHECK(a.get() == 100);
+    const auto& self = a;
+    a = self;
+    CHECK(a.get() == 100);
+
+    scattered_value<uint64_t> c(std::move(b));
+    CHECK(c.get() == 100);
+    scattered_value<uint64_t> d(5);
+    d = std::move(c);
+    CHECK(d.get() == 100);
+
+    // many live values at once must not share slots
+    std::vector<scattered_value<uint64_t>> many;
+    many.reserve(4096);
+    for (uint64_t i = 0; i < 4096; ++i) many.emplace_back(i * 0x9E3779B97F4A7C15ULL);
+    bool all = true;
+    for (uint64_t i = 0; i < 4096; ++i) all &= many[i].get() == i * 0x9E3779B97F4A7C15ULL;
+    CHECK(all);
+}
+
+TEST_CASE(scattered_value_moved_from) {
+    using cloakwork::data_hiding::scattered_value;
+
+    // a moved-from value reads as T{} and takes fresh slots on its next write
+    scattered_value<uint64_t> a(11);
+    scattered_value<uint64_t> b(std::move(a));
+    CHECK(b.get() == 11);
+    CHECK(a.get() == 0);
+    a.set(12);
+    CHECK(a.get() == 12);
+    CHECK(b.get() == 11);
+
+    scattered_value<uint64_t> c(13);
+    c = std::move(a);
+    CHECK(c.get() == 12);
+    CHECK(a.get() == 0);
+    a = b;
+    CHECK(a.get() == 11);
+
+    scattered_value<record, 8> r(make_record(5));
+    scattered_value<record, 8> taken(std::move(r));
+    r = taken;
+    CHECK(r.get().id == 5 && r.get().consistent());
+
+    // moving from a moved-from value hands over nothing, and both stay usable
+    scattered_value<uint64_t> d(std::move(b));
+    scattered_value<uint64_t> e(std::move(b));
+    CHECK(e.get() == 0);
+    e.set(14);
+    b.set(15);
+    CHECK(e.get() == 14 && b.get() == 15 && d.get() == 11);
+
+    scattered_value<uint8_t, 2> small(7);
+    scattered_value<uint8_t, 2> small_taken(std::move(small));
+    small.set(8);
+    CHECK(small.get() == 8 && small_taken.get() == 7);
+}
+
+TEST_CASE(scattered_value_seqlock_stress) {
+    // writers publish records whose fields depend on each other; readers must never see
+    // a mix of two writes
+    cloakwork::data_hiding::scattered_value<record, 8> shared(make_record(1));
+    std::atomic<bool> stop{false};
+    std::atomic<int> readers{0};
+    std::atomic<uint64_t> torn{0};
+    std::atomic<uint64_t> reads{0};
+
+    std::vector<std::thread> threads;
+    for (int w = 0; w < 2; ++w) {
+        threads.emplace_back([&, w] {
+            while (readers.load() < 4) std::this_thread::yield();
+            for (uint64_t i = 0; i < 20000; ++i) shared.set(make_record(i * 2 + w));
+        });
+    }
+    for (int r = 0; r < 4; ++r) {
+        threads.emplace_back([&] {
+            uint64_t local = 0, bad = 0;
+            readers.fetch_add(1);
+            while (!stop.load(std::memory_order_relaxed)) {
+                bad += !shared.get().consistent();
+                ++local;
+            }
+            torn.fetch_add(bad);
+            reads.fetch_add(local);
+        });
+    }
+    threads[0].join();
+    threads[1].join();
+    stop = true;
+    for (size_t t = 2; t < threads.size(); ++t) threads[t].join();
+
+    CHECK(torn.load() == 0);
+    CHECK(reads.load() > 0);
+    CHECK(shared.get().consistent());
+}
+
+TEST_CASE(concurrent_copies_and_rekeys) {
+    // copies read their source with the seqlock, and polymorphic reads re-key the value
+    // behind the readers' backs; neither may expose a value that was never stored
+    cloakwork::data_hiding::scattered_value<record, 8> shared(make_record(0));
+    cloakwork::data_hiding::polymorphic_value<uint64_t> poly(0);
+    std::atomic<int> readers{0};
+    std::atomic<bool> stop{false};
+    std::atomic<uint64_t> bad{0};
+
+    std::vector<std::thread> threads;
+    threads.emplace_back([&] {
+        while (readers.load() < 4) std::this_thread::yield();
+        for (uint64_t i = 1; i <= 20000; ++i) {
+            shared.set(make_record(i));
+            poly.set(i * 7);
+        }
+        stop = true;
+    });
+    for (int r = 0; r < 4; ++r) {
+        threads.emplace_back([&] {
+            uint64_t local = 0;
+            readers.fetch_add(1);
+            while (!stop.load(std::memory_order_relaxed)) {
+                cloakwork::data_hiding::scattered_value<record, 8> copy(shared);
+                local += !copy.get().consistent();
+                local += poly.get() % 7 != 0;
+            }
+            bad.fetch_add(local);
+        });
+    }
+    for (auto& th : threads) th.join();
+
+    CHECK(bad.load() == 0);
+    CHECK(shared.get().id == 20000);
+    CHECK(poly.get() == 20000 * 7);
+}
+
+TEST_CASE(polymorphic_value_round_trip) {
+    cloakwork::data_hiding::polymorphic_value<int> p(77);
+    bool all = true;
+    for (int i = 0; i < 1000; ++i) all &= p.get() == 77;
+    CHECK(all);
+    p.set(-5);
+    CHECK(p.get() == -5);
+
+    cloakwork::data_hiding::polymorphic_value<double> d(2.5);
+    CHECK(d.get() == 2.5);
+
+    // wider than one 64-bit word
+    cloakwork::data_hiding::polymorphic_value<long double> wide(1.0L / 3.0L);
+    all = true;
+    for (int i = 0; i < 1000; ++i) all &= wide.get() == 1.0L / 3.0L;
+    CHECK(all);
+    wide.set(-2.25L);
+    CHECK(wide.get() == -2.25L);
+}
+
+TEST_CASE(scattered_vector_round_trip) {
+    using cloakwork::data_hiding::scattered_vector;
+
+    scattered_vector<uint32_t> v;
+    CHECK(v.empty());
+    for (uint32_t i = 0; i < 1000; ++i) v.push_back(i * 7 + 1);
+    REQUIRE(v.size() == 1000);
+    CHECK(v.capacity() >= 1000);
+
+    bool all = true;
+    for (uint32_t i = 0; i < 1000; ++i) all &= v.get(i) == i * 7 + 1;
+    CHECK(all);
+
+    v.set(500, 0xABCDEF01u);
+    CHECK(v[500] == 0xABCDEF01u);
+    CHECK(v[499] == 499 * 7 + 1);
+
+    std::vector<uint32_t> out(10);
+    v.decode(495, out.size(), out.data());
+    CHECK(out[4] == 499 * 7 + 1);
+    CHECK(out[5] == 0xABCDEF01u);
+
+    v.pop_back();
+    CHECK(v.size() == 999);
+
+    scattered_vector<uint32_t> copy(v);
+    CHECK(copy.size() == 999);
+    CHECK(copy.get(500) == 0xABCDEF01u);
+    scattered_vector<uint32_t> moved(std::move(copy));
+    CHECK(moved.get(998) == 998 * 7 + 1);
+
+    scattered_vector<record, 3> records{ make_record(1), make_record(2), make_record(3) };
+    CHECK(records.size() == 3);
+    CHECK(records.get(2).id == 3 && records.get(2).consistent());
+
+    v.clear();
+    CHECK(v.empty());
+    v.push_back(5);
+    CHECK(v.get(0) == 5);
+}
+
+TEST_CASE(scattered_vector_no_default_ctor) {
+    cloakwork::data_hiding::scattered_vector<point> v;
+    for (int32_t i = 0; i < 100; ++i) v.push_back(point(i, -i));     // grows several times
+    REQUIRE(v.size() == 100);
+
+    bool all = true;
+    for (int32_t i = 0; i < 100; ++i) all &= v.get(i).x == i && v[i].y == -i;
+    CHECK(all);
+}
+
+TEST_CASE(scattered_map_no_default_ctor) {
+    cloakwork::data_hiding::scattered_map<int32_t, point> map;
+    for (int32_t i = 0; i < 100; ++i) map.set(i, point(i, -i));
+    REQUIRE(map.size() == 100);
+
+    bool all = true;
+    for (int32_t i = 0; i < 100; ++i) all &= map.get(i, point(0, 0)).x == i && map.get(i, point(0, 0)).y == -i;
+    CHECK(all);
+    CHECK(map.get(1000, point(7, 8)).x == 7);
+    CHECK(map.erase(5));
+    CHECK(map.get(5, point(-1, -1)).x == -1);
+}
+
+TEST_CASE(scattered_map_matches_reference) {
+    cloakwork::data_hiding::scattered_map<uint64_t, uint64_t> map;
+    std::unordered_map<uint64_t, uint64_t> reference;
+
+    uint64_t state = 0x243F6A8885A308D3ULL;
+    auto next = [&state] {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+
+    bool agree = true;
+    for (int i = 0; i < 20000; ++i) {
+        const uint64_t key = next() % 512;
+        switch (next() % 4) {
+            case 0:
+            case 1: {
+                const uint64_t value = next();
+                map.set(key, value);
+                reference[key] = value;
+                break;
+            }
+            case 2:
+                agree &= map.erase(key) == (reference.erase(key) == 1);
+                break;
+            default: {
+                uint64_t out = 0;
+                const auto it = reference.find(key);
+                agree &= map.try_get(key, out) == (it != reference.end());
+                if (it != reference.end()) agree &= out == it->second;
+                break;
+            }
+        }
+        agree &= map.size() == reference.size();
+    }
+    CHECK(agree);
+
+    size_t visited = 0;
+    bool values = true;
+    map.for_each([&](uint64_t key, uint64_t value) {
+        ++visited;
+        values &= reference.count(key) && reference[key] == value;
+    });
+    CHECK(visited == reference.size());
+    CHECK(values);
+
+    CHECK(map.get(100000, 7) == 7);
+    CHECK(!map.contains(100000));
+
+    map.clear();
+    CHECK(map.empty());
+    CHECK(!map.contains(reference.begin()->first));
+}
@@ -0,0 +1,95 @@
+// function obfuscation: CW_CALL and CW_FLATTEN call through to the target, the encrypted
+// dispatch table keeps its slots across set() and rekey(), and every generated variant
+// (and the dispatcher over them) computes the same result as the original function
+
+#include "test.h"
+#include "cloakwork.h"
+
+#include <cstdint>
+
+namespace {
+    int add(int a, int b) { return a + b; }
+    int sub(int a, int b) { return a - b; }
+    int mul(int a, int b) { return a * b; }
+
+    uint32_t mix(uint32_t x, uint32_t y) {
+        return (x * 0x9E3779B1u) ^ (y + (x >> 7));
+    }
+
+    uint64_t scale(uint64_t x, int32_t k) {
+        return x * static_cast<uint64_t>(k) + 11;
+    }
+}
+
+TEST_CASE(call_and_flatten) {
+    CHECK(CW_CALL(add)(20, 22) == 42);
+    CHECK(CW_CALL_P(sub, cloakwork::hot)(50, 8) == 42);
+    CHECK(CW_CALL_P(mul, cloakwork::strong)(6, 7) == 42);
+
+    // past the periodic check of every level
+    bool all = true;
+    for (int i = 0; i < 300; ++i) all &= CW_CALL(mix)(uint32_t(i), 3u) == mix(uint32_t(i), 3u);
+    CHECK(all);
+
+    CHECK(CW_FLATTEN(add, 40, 2) == 42);
+    CHECK(CW_FLATTEN(scale, uint64_t(5), -3) == scale(5, -3));
+}
+
+TEST_CASE(dispatch_table_set_get_rekey) {
+    using table_t = cloakwork::obfuscated_dispatch_table<int(int, int), 4>;
+    table_t table{ add, sub, mul };
+    CHECK(table.size() == 4);
+    CHECK(table.get(0) == &add);
+    CHECK(table.get(1) == &sub);
+    CHECK(table.get(2) == &mul);
+    CHECK(table.get(3) == nullptr);
+    CHECK(table(0, 40, 2) == 42);
+    CHECK(table(1, 44, 2) == 42);
+    CHECK(table(2, 21, 2) == 42);
+
+    // the same handler in two slots, then a few rekeys
+    table.set(3, add);
+    for (int i = 0; i < 8; ++i) {
+        table.rekey();
+        CHECK(table.get(0) == &add);
+        CHECK(table.get(1) == &sub);
+        CHECK(table.get(2) == &mul);
+        CHECK(table.get(3) == &add);
+    }
+    CHECK(table(3, 1, 41) == 42);
+
+    table.set(0, nullptr);
+    CHECK(table.get(0) == nullptr);
+    CHECK(table.get(1) == &sub);
+}
+
+TEST_CASE(generated_variants_match) {
+    // 12 variants cover every kind three times with different seeds and junk round counts
+    using mix_variants = cloakwork::metamorphic::generated_variants<&mix, 12>;
+    using scale_variants = cloakwork::metamorphic::generated_variants<&scale, 8>;
+
+    const uint32_t xs[] = { 0u, 1u, 0x7FFFFFFFu, 0x80000000u, 0xFFFFFFFFu, 12345u };
+    bool all = true;
+    for (auto* v : mix_variants::by_static_cost()) {
+        for (uint32_t x : xs) all &= v(x, x ^ 0x55u) == mix(x, x ^ 0x55u);
+    }
+    for (auto* v : scale_variants::by_static_cost()) {
+        for (uint32_t x : xs) all &= v(x, -7) == scale(x, -7);
+    }
+    CHECK(all);
+
+    // the rotating dispatcher, over every variant and over the cheapest two
+    auto every = mix_variants::dispatcher();
+    auto cheap = mix_variants::dispatcher(2);
+    for (uint32_t i = 0; i < 500; ++i) {
+        all &= every(i, 7u) == mix(i, 7u);
+        all &= cheap(i, 9u) == mix(i, 9u);
+    }
+    CHECK(all);
+
+    // and over a measured ranking
+    const auto ranking = mix_variants::measure(16, 3u, 4u);
+    auto fastest = mix_variants::dispatcher(ranking, 3);
+    for (uint32_t i = 0; i < 200; ++i) all &= fastest(i, i) == mix(i, i);
+    CHECK(all);
+}
@@ -0,0 +1,64 @@
+// hashing: crc-32 / crc-32c check values, seeded continuation, the hardware crc-32c path
+// against the table one, and fnv-1a at compile time against runtime
+
+#include "test.h"
+#include "cloakwork.h"
+
+#include <cstring>
+#include <vector>
+
+TEST_CASE(crc_check_values) {
+    using namespace cloakwork::crc;
+
+    // the standard "123456789" check values
+    CHECK(crc32("123456789", 9) == 0xCBF43926u);
+    CHECK(crc32c("123456789", 9) == 0xE3069283u);
+    CHECK(crc32("", 0) == 0);
+    CHECK(crc32c("", 0) == 0);
+
+    // rfc 3720 (iscsi) crc-32c vectors
+    std::vector<uint8_t> zeros(32, 0x00), ones(32, 0xFF), ascending(32), descending(32);
+    for (size_t i = 0; i < 32; ++i) {
+        ascending[i] = static_cast<uint8_t>(i);
+        descending[i] = static_cast<uint8_t>(31 - i);
+    }
+    CHECK(crc32c(zeros.data(), zeros.size()) == 0x8A9136AAu);
+    CHECK(crc32c(ones.data(), ones.size()) == 0x62A8AB43u);
+    CHECK(crc32c(ascending.data(), ascending.size()) == 0x46DD794Eu);
+    CHECK(crc32c(descending.data(), descending.size()) == 0x113FDB5Cu);
+
+    CHECK(crc32_ct("123456789", 9) == 0xCBF43926u);
+}
+
+TEST_CASE(crc_continuation_and_paths) {
+    using namespace cloakwork::crc;
+
+    // every length and misalignment through the slicing-by-8 and hardware loops
+    std::vector<uint8_t> data(4096 + 8);
+    uint32_t x = 0x12345678;
+    for (auto& b : data) {
+        x = x * 1664525u + 1013904223u;
+        b = static_cast<uint8_t>(x >> 24);
+    }
+
+    bool split = true, paths = true;
+    for (size_t length : { size_t(1), size_t(7), size_t(8), size_t(63), size_t(1000), size_t(4096) }) {
+        for (size_t misalign = 0; misalign < 8; ++misalign) {
+            const uint8_t* p = data.data() + misalign;
+            const size_t half = length / 2;
+            split &= crc32(p + half, length - half, crc32(p, half)) == crc32(p, length);
+            split &= crc32c(p + half, length - half, crc32c(p, half)) == crc32c(p, length);
+            paths &= ~update_slicing8<CRC32C_POLY>(~0u, p, length) == crc32c(p, length);
+        }
+    }
+    CHECK(split);
+    CHECK(paths);
+}
+
+TEST_CASE(fnv1a_compile_time_matches_runtime) {
+    using namespace cloakwork::hash;
+    CHECK(CW_HASH("kernel32.dll") == fnv1a_runtime("kernel32.dll"));
+    CHECK(CW_HASH("") == fnv1a_runtime(""));
+    CHECK(CW_HASH_CI("Kernel32.DLL") == fnv1a_runtime_ci("kernel32.dll"));
+    CHECK(CW_HASH("a") != CW_HASH("b"));
+}
@@ -0,0 +1,55 @@
+// integrity engine: a registered heap range verifies clean through pump() and verify_all(),
+// a flipped byte is reported to the handler with its chunk, and restoring it clears the
+// failure. the engine is a process-wide singleton, so the test unregisters its range and
+// removes its handler before returning
+
+#include "test.h"
+#include "cloakwork.h"
+
+#include <cstdint>
+#include <vector>
+
+#if CW_ENABLE_INTEGRITY_CHECKS
+TEST_CASE(integrity_engine_detects_tamper) {
+    auto& engine = cloakwork::integrity::integrity_engine::instance();
+
+    std::vector<uint8_t> data(10000);
+    for (size_t i = 0; i < data.size(); ++i) data[i] = static_cast<uint8_t>(i * 31 + 7);
+
+    const size_t chunks_before = engine.chunk_count();
+    const size_t id = engine.register_range(data.data(), data.size(), 1024);
+    CHECK(engine.chunk_count() == chunks_before + 10);      // 9 full chunks and a 784-byte tail
+
+    std::vector<cloakwork::integrity::integrity_engine::violation> seen;
+    engine.set_violation_handler([&seen](const auto& v) { seen.push_back(v); });
+
+    const size_t violations_before = engine.violation_count();
+    CHECK(engine.verify_all());
+    CHECK(engine.pump(1) > 0);                  // always at least one chunk
+    CHECK(engine.pump(SIZE_MAX) >= data.size());
+    CHECK(engine.violation_count() == violations_before);
+    CHECK(seen.empty());
+
+    // a flipped byte in the tail chunk
+    data[9500] ^= 0x01;
+    CHECK(!engine.verify_all());
+    CHECK(engine.violation_count() == violations_before + 1);
+    REQUIRE(seen.size() == 1);
+    CHECK(seen[0].address == data.data() + 9216);
+    CHECK(seen[0].size == 784);
+    CHECK(seen[0].expected != seen[0].actual);
+    CHECK(engine.last_violation().address == seen[0].address);
+
+    // the round-robin path finds it too
+    engine.pump(SIZE_MAX);
+    CHECK(seen.size() == 2);
+
+    data[9500] ^= 0x01;
+    CHECK(engine.verify_all());
+    CHECK(seen.size() == 2);
+
+    engine.set_violation_handler(nullptr);
+    engine.unregister_range(id);
+    CHECK(engine.chunk_count() == chunks_before);
+}
+#endif
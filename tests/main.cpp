@@ -0,0 +1,21 @@
+// cloakwork_tests - behaviour tests for the header library
+//
+// usage: cloakwork_tests [substring]      (runs every test whose name contains it)
+
+#include "test.h"
+
+#include <cstring>
+
+int main(int argc, char** argv) {
+    const char* filter = argc > 1 ? argv[1] : nullptr;
+    size_t run = 0;
+    for (const auto& test : cw_test::registry()) {
+        if (filter && !std::strstr(test.name, filter)) continue;
+        const size_t before = cw_test::failures();
+        test.fn();
+        std::printf("%-40s %s\n", test.name, cw_test::failures() == before ? "ok" : "FAILED");
+        ++run;
+    }
+    std::printf("%zu tests, %zu failed checks\n", run, cw_test::failures());
+    return cw_test::failures() == 0 ? 0 : 1;
+}
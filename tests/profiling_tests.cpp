@@ -0,0 +1,39 @@
+// profiling: a wrapped site shows up in both dump formats with its call count, and the
+// json dump reports how many sites did not fit the per-thread tables
+
+#include "test.h"
+#include "cloakwork.h"
+
+#include <cstdio>
+#include <string>
+
+#if CW_ENABLE_PROFILING
+namespace {
+    std::string dump_to_string(const char* format) {
+        std::FILE* f = std::tmpfile();
+        if (!f) return {};
+        cloakwork::profiling::registry::instance().dump(f, format);
+        std::string text;
+        std::rewind(f);
+        for (int c; (c = std::fgetc(f)) != EOF;) text.push_back(static_cast<char>(c));
+        std::fclose(f);
+        return text;
+    }
+}
+
+TEST_CASE(profile_dump_formats) {
+    int sum = 0;
+    for (int i = 0; i < 5; ++i) sum += CW_PROFILE_WRAP("profiled_site", i);
+    CHECK(sum == 10);
+
+    const std::string json = dump_to_string("json");
+    CHECK(json.find("\"dropped_sites\": 0,") != std::string::npos);
+    CHECK(json.find("{\"kind\": \"profiled_site\"") != std::string::npos);
+    CHECK(json.find("\"calls\": 5,") != std::string::npos);
+
+    const std::string csv = dump_to_string("csv");
+    CHECK(csv.rfind("kind,file,line,calls,", 0) == 0);
+    CHECK(csv.find("profiled_site,\"") != std::string::npos);
+    CHECK(csv.find("# dropped_sites") == std::string::npos);
+}
+#endif
@@ -0,0 +1,151 @@
+// secret arena: slot class boundaries, zeroed slots after a free in every class, large-block
+// accounting, secret_buffer ownership transfer, and the secure_wipe / secure_scramble helpers
+
+#include "test.h"
+#include "cloakwork.h"
+
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace {
+    using cloakwork::memory::secret_arena;
+    using cloakwork::memory::secret_buffer;
+
+    bool all_zero(const void* p, size_t n) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(p);
+        for (size_t i = 0; i < n; ++i) {
+            if (bytes[i]) return false;
+        }
+        return true;
+    }
+}
+
+TEST_CASE(secret_arena_class_boundaries) {
+    CHECK(secret_arena::class_index(1) == 0);
+    CHECK(secret_arena::class_index(32) == 0);
+    CHECK(secret_arena::class_index(33) == 1);
+    CHECK(secret_arena::class_index(64) == 1);
+    CHECK(secret_arena::class_index(65) == 2);
+    CHECK(secret_arena::class_index(2048) == 6);
+    CHECK(secret_arena::class_index(2049) == 7);
+    CHECK(secret_arena::class_index(4096) == secret_arena::CLASS_COUNT - 1);
+    CHECK(secret_arena::slot_size(secret_arena::CLASS_COUNT - 1) == secret_arena::MAX_SLOT);
+    CHECK(secret_arena::MAX_SLOT == 4096);
+
+    // 4096 bytes is still a slot, 4097 bytes gets pages of its own
+    secret_arena& arena = secret_arena::instance();
+    const size_t before = arena.stats().in_use;
+    void* slot = arena.allocate(4096);
+    CHECK(arena.stats().in_use == before + 4096);
+    void* large = arena.allocate(4097);
+    CHECK(arena.stats().in_use > before + 4096 + 4097);
+    arena.deallocate(large, 4097);
+    arena.deallocate(slot, 4096);
+    CHECK(arena.stats().in_use == before);
+    CHECK(arena.allocate(0) == nullptr);
+}
+
+TEST_CASE(secret_arena_slots_come_back_zeroed) {
+    secret_arena& arena = secret_arena::instance();
+    bool zeroed = true, reused = true, aligned = true;
+    for (size_t cls = 0; cls < secret_arena::CLASS_COUNT; ++cls) {
+        const size_t size = secret_arena::slot_size(cls);
+        uint8_t* p = static_cast<uint8_t*>(arena.allocate(size));
+        aligned &= reinterpret_cast<uintptr_t>(p) % size == 0;
+        zeroed &= all_zero(p, size);
+        std::memset(p, 0xA5, size);
+        arena.deallocate(p, size);
+
+        // the free list hands the same slot back, wiped (link word included)
+        uint8_t* q = static_cast<uint8_t*>(arena.allocate(size));
+        reused &= q == p;
+        zeroed &= all_zero(q, size);
+        arena.deallocate(q, size);
+    }
+    CHECK(zeroed);
+    CHECK(reused);
+    CHECK(aligned);
+}
+
+TEST_CASE(secret_arena_large_accounting) {
+    secret_arena& arena = secret_arena::instance();
+    const auto before = arena.stats();
+
+    void* a = arena.allocate(100000);
+    void* b = arena.allocate(5000);
+    const auto during = arena.stats();
+    CHECK(during.in_use >= before.in_use + 105000);
+    CHECK(during.mapped >= before.mapped + 105000);
+    CHECK(during.locked <= during.mapped);
+    CHECK(all_zero(a, 100000));
+    std::memset(a, 0x5A, 100000);
+
+    arena.deallocate(a, 100000);
+    arena.deallocate(b, 5000);
+    const auto after = arena.stats();
+    CHECK(after.in_use == before.in_use);
+    CHECK(after.mapped == before.mapped);
+    CHECK(after.locked == before.locked);
+}
+
+TEST_CASE(secret_buffer_ownership) {
+    secret_arena& arena = secret_arena::instance();
+    const size_t before = arena.stats().in_use;
+    {
+        secret_buffer a(100);
+        uint8_t* p = a.data();
+        REQUIRE(p);
+        CHECK(a.size() == 100);
+        std::memset(p, 0x11, a.size());
+
+        secret_buffer b(std::move(a));
+        CHECK(a.data() == nullptr);
+        CHECK(a.size() == 0);
+        CHECK(b.data() == p);
+        CHECK(b.size() == 100);
+        CHECK(arena.stats().in_use == before + 128);
+
+        // assignment releases the target's own slot first
+        secret_buffer c(10);
+        c = std::move(b);
+        CHECK(c.data() == p);
+        CHECK(b.data() == nullptr);
+        CHECK(arena.stats().in_use == before + 128);
+        CHECK(c.data()[99] == 0x11);
+    }
+    CHECK(arena.stats().in_use == before);
+
+    secret_buffer none;
+    CHECK(none.data() == nullptr);
+    CHECK(none.size() == 0);
+}
+
+TEST_CASE(secure_wipe_and_scramble) {
+    // odd lengths cover the tail after the 32-byte scramble words
+    for (size_t n : { size_t(1), size_t(31), size_t(32), size_t(33), size_t(1000) }) {
+        std::vector<uint8_t> buf(n + 2, 0xAA);
+        cloakwork::secure_wipe(buf.data() + 1, n);
+        CHECK(all_zero(buf.data() + 1, n));
+        CHECK(buf.front() == 0xAA);
+        CHECK(buf.back() == 0xAA);
+
+        cloakwork::secure_scramble(buf.data() + 1, n);
+        CHECK(buf.front() == 0xAA);
+        CHECK(buf.back() == 0xAA);
+        if (n >= 32) {
+            // noise, not zeros or a constant fill
+            size_t zeros = 0;
+            for (size_t i = 1; i <= n; ++i) zeros += buf[i] == 0;
+            CHECK(zeros < n / 8 + 1);
+            CHECK(buf[1] != buf[2] || buf[2] != buf[3] || buf[3] != buf[4]);
+        }
+    }
+
+    // zero lengths touch nothing
+    uint8_t byte = 0x5C;
+    cloakwork::secure_wipe(&byte, 0);
+    cloakwork::secure_scramble(&byte, 0);
+    CHECK(byte == 0x5C);
+}
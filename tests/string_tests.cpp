@@ -0,0 +1,194 @@
+// string encryption: round-trips through every macro, equals() against plain and
+// decrypted storage, warmup / cooldown / reencrypt_all, the polled idle reseal policy, and
+// range reads of the counter-mode strings
+
+#include "test.h"
+#include "cloakwork.h"
+
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+TEST_CASE(str_round_trip) {
+    CHECK(std::strcmp(CW_STR("hello cloakwork"), "hello cloakwork") == 0);
+    CHECK(std::strcmp(CW_STR(""), "") == 0);
+    CHECK(std::strcmp(CW_STR_LAYERED("layered literal"), "layered literal") == 0);
+    CHECK(std::wcscmp(CW_WSTR(L"wide literal"), L"wide literal") == 0);
+
+    auto stack = CW_STR_STACK("stack literal");
+    CHECK(std::strcmp(static_cast<const char*>(stack), "stack literal") == 0);
+
+    // the same site hands out the same text every time
+    for (int i = 0; i < 3; ++i) {
+        CHECK(std::string(CW_STR("repeat")) == "repeat");
+    }
+}
+
+TEST_CASE(str_concurrent_get) {
+    std::vector<std::thread> threads;
+    std::vector<int> ok(8, 0);
+    for (size_t t = 0; t < ok.size(); ++t) {
+        threads.emplace_back([&ok, t] {
+            int good = 1;
+            for (int i = 0; i < 10000; ++i) {
+                good &= std::strcmp(CW_STR("shared across threads"), "shared across threads") == 0;
+            }
+            ok[t] = good;
+        });
+    }
+    for (auto& th : threads) th.join();
+    for (int good : ok) CHECK(good);
+}
+
+TEST_CASE(str_equals) {
+    CHECK(CW_STR_EQ("password123", "password123"));
+    CHECK(!CW_STR_EQ("password124", "password123"));
+    CHECK(!CW_STR_EQ("password12", "password123"));
+    CHECK(!CW_STR_EQ("password1234", "password123"));
+    CHECK(!CW_STR_EQ("", "password123"));
+    CHECK(CW_STR_EQ(std::string("runtime"), "runtime"));
+}
+
+#if CW_ENABLE_STRING_ENCRYPTION
+TEST_CASE(str_equals_any_state) {
+    // equals() has to agree with the literal whether or not get() decrypted the storage
+    static cloakwork::string_encrypt::encrypted_string<sizeof("secret value")> enc("secret value");
+    CHECK(enc.equals("secret value"));
+    CHECK(!enc.equals("secret valuE"));
+
+    CHECK(std::strcmp(enc.get(), "secret value") == 0);
+    CHECK(enc.equals("secret value"));
+    CHECK(!enc.equals("Secret value"));
+
+    enc.reencrypt();
+    CHECK(enc.equals("secret value"));
+    CHECK(!enc.equals("secret valu"));
+    CHECK(std::strcmp(enc.get(), "secret value") == 0);
+}
+
+TEST_CASE(str_stack_leaves_source_encrypted) {
+    // the stack copy decrypts from the ciphertext: the source is never decrypted in place,
+    // so it is never listed as holding plaintext
+    static cloakwork::string_encrypt::encrypted_string<sizeof("stack source")> enc("stack source");
+    const size_t listed = cloakwork::registry::live_count();
+    {
+        cloakwork::string_encrypt::stack_encrypted_string<sizeof("stack source")> stack(enc);
+        CHECK(std::strcmp(stack.get(), "stack source") == 0);
+    }
+    CHECK(cloakwork::registry::live_count() == listed);
+    CHECK(enc.equals("stack source"));
+
+    // and still right once a get() has decrypted it
+    CHECK(std::strcmp(enc.get(), "stack source") == 0);
+    cloakwork::string_encrypt::stack_encrypted_string<sizeof("stack source")> again(enc);
+    CHECK(std::strcmp(again.get(), "stack source") == 0);
+}
+
+namespace {
+    // a custom warm task, enrolled once for the whole run (tasks are never removed)
+    struct warm_counter {
+        int warmed = 0;
+        int cooled = 0;
+    };
+
+    warm_counter counter;
+    cloakwork::registry::warm_task counter_task{
+        [](void* ctx, bool warm) {
+            auto* c = static_cast<warm_counter*>(ctx);
+            if (warm) ++c->warmed; else ++c->cooled;
+        },
+        &counter, nullptr };
+}
+
+TEST_CASE(str_warmup_cooldown) {
+    static bool enrolled = false;
+    if (!enrolled) {
+        cloakwork::registry::enroll(counter_task);
+        enrolled = true;
+    }
+    const warm_counter before = counter;
+
+    const size_t warmed = cloakwork::warmup(2);
+    CHECK(warmed >= 1);
+    CHECK(warmed == cloakwork::registry::warm_count());
+    CHECK(counter.warmed == before.warmed + 1);
+    CHECK(counter.cooled == before.cooled);
+
+    CHECK(cloakwork::cooldown(1) == warmed);
+    CHECK(counter.warmed == before.warmed + 1);
+    CHECK(counter.cooled == before.cooled + 1);
+
+    // enrolled sites still hand out their text after a cooldown
+    CHECK(std::strcmp(CW_STR("after cooldown"), "after cooldown") == 0);
+}
+
+TEST_CASE(str_reencrypt_all) {
+    static cloakwork::string_encrypt::encrypted_string<sizeof("resealed literal")> enc("resealed literal");
+    CHECK(std::strcmp(enc.get(), "resealed literal") == 0);
+    CHECK(cloakwork::reencrypt_all() >= 1);
+
+    // the object was resealed, so the next get() takes the decrypt slow path again
+    const uint64_t epoch = cloakwork::registry::decrypt_epoch.load();
+    CHECK(std::strcmp(enc.get(), "resealed literal") == 0);
+    CHECK(cloakwork::registry::decrypt_epoch.load() > epoch);
+
+    // while a second get() without a reseal stays on the fast path
+    const uint64_t warm_epoch = cloakwork::registry::decrypt_epoch.load();
+    CHECK(std::strcmp(enc.get(), "resealed literal") == 0);
+    CHECK(cloakwork::registry::decrypt_epoch.load() == warm_epoch);
+}
+
+TEST_CASE(str_idle_resealer_poll) {
+    // no background thread: a pass runs only from poll(), once per quiet period
+    cloakwork::registry::idle_resealer policy(std::chrono::milliseconds(0));
+    CHECK(policy.poll());
+    CHECK(!policy.poll());
+    CHECK(policy.passes() == 1);
+
+    static cloakwork::string_encrypt::encrypted_string<sizeof("idle literal")> enc("idle literal");
+    CHECK(std::strcmp(enc.get(), "idle literal") == 0);
+    CHECK(!policy.poll());      // saw the decrypt, the quiet period starts over
+    CHECK(policy.poll());
+    CHECK(policy.passes() == 2);
+    CHECK(std::strcmp(enc.get(), "idle literal") == 0);
+}
+#endif
+
+TEST_CASE(str_stream_round_trip) {
+    CHECK(std::strcmp(CW_STR_ARX("counter mode literal"), "counter mode literal") == 0);
+
+    const std::string text(
+        "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ"
+        "the quick brown fox jumps over the lazy dog, twice over: "
+        "the quick brown fox jumps over the lazy dog");
+    const auto& stream = CW_STR_STREAM(
+        "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ"
+        "the quick brown fox jumps over the lazy dog, twice over: "
+        "the quick brown fox jumps over the lazy dog");
+    REQUIRE(stream.size() == text.size());
+
+    // every range, including ones that straddle a 64-byte keystream block
+    char buf[160];
+    for (size_t offset = 0; offset < text.size(); offset += 7) {
+        for (size_t length : { size_t(1), size_t(13), size_t(64), size_t(150) }) {
+            const size_t n = stream.read(offset, length, buf);
+            CHECK(n == std::min(length, text.size() - offset));
+            CHECK(std::memcmp(buf, text.data() + offset, n) == 0);
+        }
+    }
+    CHECK(stream.read(text.size(), 4, buf) == 0);
+    CHECK(stream.at(10) == 'a');
+
+    CHECK(stream.equals(text));
+    CHECK(!stream.equals(text.substr(1)));
+    std::string wrong = text;
+    wrong.back() = '?';
+    CHECK(!stream.equals(wrong));
+
+    CHECK(std::string(stream.get()) == text);
+    CHECK(stream.equals(text));
+    CHECK(!stream.equals(wrong));
+}
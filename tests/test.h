@@ -0,0 +1,53 @@
+// tests/test.h - minimal self-registering test harness for cloakwork_tests
+//
+// TEST_CASE(name) { ... } defines and registers a test; CHECK(expr) records a failure
+// and keeps going, REQUIRE(expr) also returns from the test. no dependencies beyond the
+// standard library, so the tests build wherever the headers do.
+
+#ifndef CLOAKWORK_TESTS_TEST_H
+#define CLOAKWORK_TESTS_TEST_H
+
+#include <cstdio>
+#include <vector>
+
+namespace cw_test {
+
+    struct test_case {
+        const char* name;
+        void (*fn)();
+    };
+
+    inline std::vector<test_case>& registry() {
+        static std::vector<test_case> tests;
+        return tests;
+    }
+
+    inline size_t& failures() {
+        static size_t count = 0;
+        return count;
+    }
+
+    struct registrar {
+        registrar(const char* name, void (*fn)()) {
+            registry().push_back({ name, fn });
+        }
+    };
+
+    inline bool check(bool ok, const char* expr, const char* file, int line) {
+        if (!ok) {
+            ++failures();
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", file, line, expr);
+        }
+        return ok;
+    }
+}
+
+#define TEST_CASE(name) \
+    static void name(); \
+    static cw_test::registrar name##_registrar(#name, name); \
+    static void name()
+
+#define CHECK(expr) cw_test::check(static_cast<bool>(expr), #expr, __FILE__, __LINE__)
+#define REQUIRE(expr) do { if (!CHECK(expr)) return; } while (0)
+
+#endif // CLOAKWORK_TESTS_TEST_H
@@ -0,0 +1,65 @@
+// values: CW_INT / CW_MBA round-trips at every protection level, and encrypted
+// compile-time constants from literals and from named constexpr constants (whose
+// decltype is cv-qualified)
+
+#include "test.h"
+#include "cloakwork.h"
+
+#include <cstdint>
+
+namespace {
+    constexpr int kLimit = 42;
+    constexpr uint64_t kWide = 0xDEADBEEFCAFEF00Dull;
+    constexpr int8_t kNegative = -7;
+}
+
+TEST_CASE(int_round_trip) {
+    bool all = true;
+    for (int i = -1000; i <= 1000; i += 7) {
+        int plain = CW_INT(i);
+        int mba = CW_MBA(i);
+        all &= plain == i && mba == i;
+    }
+    CHECK(all);
+
+    const int64_t wide = CW_INT(int64_t(-0x123456789ABCDEF));
+    CHECK(wide == -0x123456789ABCDEF);
+    const uint8_t small = CW_MBA(uint8_t(0xFE));
+    CHECK(small == 0xFE);
+
+    CHECK(int(CW_INT_P(41, cloakwork::hot)) == 41);
+    CHECK(int(CW_INT_P(42, cloakwork::light)) == 42);
+    CHECK(int(CW_INT_P(43, cloakwork::standard)) == 43);
+    CHECK(int(CW_INT_P(44, cloakwork::strong)) == 44);
+}
+
+TEST_CASE(int_set_and_reread) {
+    // enough reads to pass the periodic check of every level
+    cloakwork::obfuscated_value<int, cloakwork::level::strong> value(5);
+    cloakwork::mba_obfuscated<uint32_t> mba(7);
+    bool all = true;
+    for (int i = 0; i < 2500; ++i) {
+        value = i;
+        mba = static_cast<uint32_t>(i * 3);
+        all &= value.get() == i && mba.get() == static_cast<uint32_t>(i * 3);
+    }
+    CHECK(all);
+}
+
+TEST_CASE(const_literals) {
+    CHECK(CW_CONST(0x5EED1234) == 0x5EED1234);
+    CHECK(CW_CONST_MBA(0x5EED1234) == 0x5EED1234);
+    CHECK(CW_CONST(-1) == -1);
+}
+
+TEST_CASE(const_named_constexpr) {
+    CHECK(CW_CONST(kLimit) == 42);
+    CHECK(CW_CONST_MBA(kLimit) == 42);
+    CHECK(CW_CONST(kWide) == kWide);
+    CHECK(CW_CONST_MBA(kWide) == kWide);
+    CHECK(CW_CONST(kNegative) == -7);
+    CHECK(CW_CONST_MBA(kNegative) == -7);
+
+    // a const-qualified T given directly
+    CHECK((cloakwork::constants::encrypted_constant<const int, kLimit>::get()) == 42);
+}
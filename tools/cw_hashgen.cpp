@@ -0,0 +1,222 @@
+// cw_hashgen - post-link expected-hash generator for CW_INTEGRITY_PRECOMPUTED
+//
+// reads a linked elf64 binary, finds every hash_entry in the "cwhashes" section,
+// resolves the function it points at (including pie/shared-object relative relocations),
+// looks up the real symbol size in .symtab/.dynsym and writes size + crc32c back into the
+// entry. run it after every link, before stripping:
+//
+//   g++ -std=c++20 -O2 -o cw_hashgen tools/cw_hashgen.cpp
+//   ./cw_hashgen ./your_binary
+//
+// linux / elf64 little-endian only (x86-64, aarch64)
+
+#define CW_ENABLE_ALL 0
+#include "../cloakwork.h"
+
+#include <elf.h>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace {
+    // mirrors cloakwork::integrity::hash_entry on 64-bit targets
+    struct raw_entry {
+        uint32_t magic;
+        uint32_t flags;
+        uint64_t func;
+        uint64_t size;
+        uint32_t crc;
+        uint32_t reserved;
+    };
+    static_assert(sizeof(raw_entry) == 32);
+
+    constexpr size_t FUNC_OFFSET = offsetof(raw_entry, func);
+
+    class elf_image {
+    public:
+        std::vector<uint8_t> bytes;
+
+        bool load(const std::string& path) {
+            std::ifstream in(path, std::ios::binary);
+            if (!in) return false;
+            bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+            return valid();
+        }
+
+        bool save(const std::string& path) const {
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+            return static_cast<bool>(out);
+        }
+
+        template<typename T>
+        T read(size_t offset) const {
+            T value{};
+            if (offset + sizeof(T) <= bytes.size()) std::memcpy(&value, bytes.data() + offset, sizeof(T));
+            return value;
+        }
+
+        template<typename T>
+        void write(size_t offset, const T& value) {
+            std::memcpy(bytes.data() + offset, &value, sizeof(T));
+        }
+
+        const Elf64_Ehdr& header() const { return *reinterpret_cast<const Elf64_Ehdr*>(bytes.data()); }
+
+        std::vector<Elf64_Shdr> sections() const {
+            std::vector<Elf64_Shdr> out;
+            for (size_t i = 0; i < header().e_shnum; ++i) {
+                out.push_back(read<Elf64_Shdr>(header().e_shoff + i * header().e_shentsize));
+            }
+            return out;
+        }
+
+        std::vector<Elf64_Phdr> segments() const {
+            std::vector<Elf64_Phdr> out;
+            for (size_t i = 0; i < header().e_phnum; ++i) {
+                out.push_back(read<Elf64_Phdr>(header().e_phoff + i * header().e_phentsize));
+            }
+            return out;
+        }
+
+        std::string section_name(const Elf64_Shdr& sh) const {
+            const Elf64_Shdr names = read<Elf64_Shdr>(header().e_shoff + header().e_shstrndx * header().e_shentsize);
+            return reinterpret_cast<const char*>(bytes.data() + names.sh_offset + sh.sh_name);
+        }
+
+        // file offset of a virtual address, or SIZE_MAX if it is not file-backed
+        size_t file_offset(uint64_t vaddr, uint64_t length) const {
+            for (const auto& ph : segments()) {
+                if (ph.p_type != PT_LOAD) continue;
+                if (vaddr >= ph.p_vaddr && vaddr + length <= ph.p_vaddr + ph.p_filesz) {
+                    return static_cast<size_t>(ph.p_offset + (vaddr - ph.p_vaddr));
+                }
+            }
+            return SIZE_MAX;
+        }
+
+    private:
+        bool valid() const {
+            if (bytes.size() < sizeof(Elf64_Ehdr)) return false;
+            const auto& eh = header();
+            return std::memcmp(eh.e_ident, ELFMAG, SELFMAG) == 0 &&
+                   eh.e_ident[EI_CLASS] == ELFCLASS64 &&
+                   eh.e_ident[EI_DATA] == ELFDATA2LSB &&
+                   eh.e_shoff != 0;
+        }
+    };
+
+    bool is_relative(uint32_t type) {
+        return type == R_X86_64_RELATIVE || type == R_AARCH64_RELATIVE;
+    }
+
+    // resolves the function pointer stored at `slot_vaddr`, looking at dynamic
+    // relocations first (pie and shared objects leave the slot zero)
+    uint64_t resolve_pointer(const elf_image& elf, const std::vector<Elf64_Shdr>& sections, uint64_t slot_vaddr, uint64_t in_file) {
+        for (const auto& sh : sections) {
+            if (sh.sh_type != SHT_RELA || !sh.sh_entsize) continue;
+
+            const Elf64_Shdr* symtab = sh.sh_link < sections.size() ? &sections[sh.sh_link] : nullptr;
+            for (uint64_t off = 0; off + sizeof(Elf64_Rela) <= sh.sh_size; off += sh.sh_entsize) {
+                auto rela = elf.read<Elf64_Rela>(sh.sh_offset + off);
+                if (rela.r_offset != slot_vaddr) continue;
+
+                uint32_t type = ELF64_R_TYPE(rela.r_info);
+                uint32_t sym = ELF64_R_SYM(rela.r_info);
+                if (is_relative(type) || sym == 0) return static_cast<uint64_t>(rela.r_addend);
+
+                if (symtab && symtab->sh_entsize) {
+                    auto s = elf.read<Elf64_Sym>(symtab->sh_offset + sym * symtab->sh_entsize);
+                    if (s.st_shndx != SHN_UNDEF) return s.st_value + static_cast<uint64_t>(rela.r_addend);
+                }
+                return 0;
+            }
+        }
+        return in_file;
+    }
+
+    // size of the function symbol starting at `vaddr`, preferring .symtab over .dynsym
+    uint64_t symbol_size(const elf_image& elf, const std::vector<Elf64_Shdr>& sections, uint64_t vaddr, std::string& name) {
+        for (uint32_t wanted : {static_cast<uint32_t>(SHT_SYMTAB), static_cast<uint32_t>(SHT_DYNSYM)}) {
+            for (const auto& sh : sections) {
+                if (sh.sh_type != wanted || !sh.sh_entsize) continue;
+                const Elf64_Shdr& strtab = sections[sh.sh_link];
+
+                for (uint64_t off = 0; off + sizeof(Elf64_Sym) <= sh.sh_size; off += sh.sh_entsize) {
+                    auto s = elf.read<Elf64_Sym>(sh.sh_offset + off);
+                    if (ELF64_ST_TYPE(s.st_info) != STT_FUNC || s.st_value != vaddr || s.st_size == 0) continue;
+                    name = reinterpret_cast<const char*>(elf.bytes.data() + strtab.sh_offset + s.st_name);
+                    return s.st_size;
+                }
+            }
+        }
+        return 0;
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        std::cerr << "usage: " << argv[0] << " <elf-binary>" << std::endl;
+        return 2;
+    }
+
+    const std::string path = argv[1];
+    elf_image elf;
+    if (!elf.load(path)) {
+        std::cerr << "cw_hashgen: " << path << " is not a readable elf64 little-endian file" << std::endl;
+        return 1;
+    }
+
+    const auto sections = elf.sections();
+    const Elf64_Shdr* table = nullptr;
+    for (const auto& sh : sections) {
+        if (elf.section_name(sh) == "cwhashes") table = &sh;
+    }
+    if (!table) {
+        std::cout << "cw_hashgen: no cwhashes section, nothing to do" << std::endl;
+        return 0;
+    }
+
+    size_t patched = 0, failed = 0;
+    for (uint64_t off = 0; off + sizeof(raw_entry) <= table->sh_size;) {
+        const size_t at = static_cast<size_t>(table->sh_offset + off);
+        auto entry = elf.read<raw_entry>(at);
+        if (entry.magic != cloakwork::integrity::HASH_ENTRY_MAGIC) {
+            off += alignof(raw_entry);
+            continue;
+        }
+
+        uint64_t func = resolve_pointer(elf, sections, table->sh_addr + off + FUNC_OFFSET, entry.func);
+        std::string name;
+        uint64_t size = func ? symbol_size(elf, sections, func, name) : 0;
+        size_t code = size ? elf.file_offset(func, size) : SIZE_MAX;
+
+        if (code == SIZE_MAX) {
+            std::cerr << "cw_hashgen: entry at 0x" << std::hex << table->sh_addr + off << std::dec
+                      << ": no sized function symbol at 0x" << std::hex << func << std::dec << std::endl;
+            ++failed;
+        } else {
+            entry.size = size;
+            entry.crc = cloakwork::crc::crc32c(elf.bytes.data() + code, static_cast<size_t>(size));
+            entry.flags |= cloakwork::integrity::HASH_ENTRY_PATCHED;
+            elf.write(at, entry);
+            ++patched;
+
+            char crc[9];
+            std::snprintf(crc, sizeof(crc), "%08x", entry.crc);
+            std::cout << "  " << name << "  size=" << size << "  crc32c=" << crc << std::endl;
+        }
+        off += sizeof(raw_entry);
+    }
+
+    if (patched && !elf.save(path)) {
+        std::cerr << "cw_hashgen: failed to write " << path << std::endl;
+        return 1;
+    }
+
+    std::cout << "cw_hashgen: patched " << patched << " entr" << (patched == 1 ? "y" : "ies") << std::endl;
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,229 @@
+// cw_pack - build-time packer for cloakwork::asset::encrypted_asset / encrypted_archive
+//
+// encrypts a file into the chunked asset format read by cloakwork/asset.h, or many files
+// into one archive indexed by CW_HASH(name). the output is either the packed file itself
+// (load it with encrypted_asset::open / encrypted_archive::open or embed it with
+// CW_ASSET_INCBIN) or a c++ header holding it as an array, for toolchains without .incbin:
+//
+//   g++ -std=c++20 -O2 -o cw_pack tools/cw_pack.cpp
+//   ./cw_pack --passphrase "build secret" model.bin model.cwa
+//   ./cw_pack --passphrase "build secret" --header shaders shaders.bin shaders_asset.h
+//   ./cw_pack --passphrase "build secret" --archive templates.cwr home.html mail/welcome=welcome.txt
+//
+// archive entries are named by their path as given, or by the part before '=' (look them up
+// with CW_HASH("mail/welcome")).
+//
+// the program opens the asset with CW_ASSET_KEY("build secret"). the nonce defaults to one
+// derived from the content, so packing the same input twice gives the same bytes. the cipher
+// is recorded in the header, so --cipher needs no matching change in the program.
+
+#define CW_ENABLE_ALL 0
+#include "../cloakwork/asset.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+    void usage(const char* self) {
+        std::cerr << "usage: " << self << " (--passphrase TEXT | --key HEX32) [--chunk BYTES] [--nonce HEX]\n"
+                  << "       [--cipher NAME] [--header NAME] (<input> <output> | --archive <output> [name=]<input>...)\n"
+                  << "  --passphrase  derive the key like CW_ASSET_KEY(TEXT)\n"
+                  << "  --key         raw 128-bit key as 32 hex digits (words w[0..3], big-endian each)\n"
+                  << "  --chunk       plaintext bytes per chunk, multiple of 64 (default "
+                  << cloakwork::asset::DEFAULT_CHUNK_SIZE << ")\n"
+                  << "  --nonce       fixed 64-bit nonce instead of the content-derived one\n"
+                  << "  --cipher      ctr32 (default), arx8, arx12 or arx20\n"
+                  << "  --header      write a c++ header defining NAME[] and NAME_size instead of a binary\n"
+                  << "  --archive     pack every input into one encrypted_archive" << std::endl;
+    }
+
+    bool parse_key(const std::string& hex, cloakwork::asset::key128& key) {
+        if (hex.size() != 32) return false;
+        for (size_t i = 0; i < 4; ++i) {
+            char* end = nullptr;
+            const std::string part = hex.substr(i * 8, 8);
+            key.w[i] = static_cast<uint32_t>(std::strtoul(part.c_str(), &end, 16));
+            if (*end != '\0') return false;
+        }
+        return true;
+    }
+
+    bool parse_cipher(const std::string& name, uint16_t& cipher) {
+        if (name == "ctr32") cipher = cloakwork::asset::CIPHER_CTR32;
+        else if (name == "arx8") cipher = cloakwork::asset::CIPHER_ARX8;
+        else if (name == "arx12") cipher = cloakwork::asset::CIPHER_ARX12;
+        else if (name == "arx20") cipher = cloakwork::asset::CIPHER_ARX20;
+        else return false;
+        return true;
+    }
+
+    bool write_header(const std::string& path, const std::string& name, const std::vector<uint8_t>& packed) {
+        std::ofstream out(path, std::ios::trunc);
+        out << "// generated by cw_pack - encrypted asset, open with cloakwork::asset::encrypted_asset\n"
+            << "#pragma once\n"
+            << "#include <cstddef>\n\n"
+            << "alignas(64) inline constexpr unsigned char " << name << "[] = {";
+        char byte[8];
+        for (size_t i = 0; i < packed.size(); ++i) {
+            std::snprintf(byte, sizeof(byte), "0x%02x", packed[i]);
+            out << (i == 0 ? "\n    " : i % 16 ? ", " : ",\n    ") << byte;
+        }
+        out << "\n};\n"
+            << "inline constexpr size_t " << name << "_size = sizeof(" << name << ");\n";
+        return static_cast<bool>(out);
+    }
+
+    bool write_output(const std::string& path, const std::string& header_name, const std::vector<uint8_t>& packed) {
+        if (!header_name.empty()) return write_header(path, header_name, packed);
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(packed.data()), static_cast<std::streamsize>(packed.size()));
+        return static_cast<bool>(out);
+    }
+
+    int pack_archive(const std::vector<std::string>& args, const cloakwork::asset::key128& key, uint64_t nonce,
+                     uint16_t cipher, const std::string& header_name) {
+        const std::string& output = args[0];
+        std::vector<cloakwork::asset::mapped_file> inputs(args.size() - 1);
+        std::vector<std::string> names(inputs.size());
+        cloakwork::asset::archive_builder builder;
+
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            const std::string& arg = args[i + 1];
+            const size_t eq = arg.find('=');
+            names[i] = eq == std::string::npos ? arg : arg.substr(0, eq);
+            const std::string path = eq == std::string::npos ? arg : arg.substr(eq + 1);
+
+            // empty files cannot be mapped but are still valid entries
+            const bool mapped = inputs[i].open(path.c_str());
+            if (!mapped && !std::ifstream(path)) {
+                std::cerr << "cw_pack: cannot read " << path << std::endl;
+                return 1;
+            }
+            if (!builder.add(names[i].c_str(), inputs[i].data(), inputs[i].size())) {
+                std::cerr << "cw_pack: " << names[i] << " duplicates the name hash of an earlier entry" << std::endl;
+                return 1;
+            }
+        }
+
+        const std::vector<uint8_t> packed = builder.build(key, nonce, cipher);
+        cloakwork::asset::encrypted_archive check(packed.data(), packed.size(), key);
+        bool ok = check.valid() && check.size() == inputs.size();
+        for (size_t i = 0; ok && i < inputs.size(); ++i) {
+            const auto entry = check.find(names[i].c_str());
+            std::vector<uint8_t> plain(inputs[i].size());
+            ok = entry && entry.size() == inputs[i].size() && entry.decrypt_to(plain.data(), true);
+        }
+        if (!ok) {
+            std::cerr << "cw_pack: round-trip verification failed" << std::endl;
+            return 1;
+        }
+        if (!write_output(output, header_name, packed)) {
+            std::cerr << "cw_pack: failed to write " << output << std::endl;
+            return 1;
+        }
+
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            char hash[9];
+            std::snprintf(hash, sizeof(hash), "%08x", cloakwork::hash::fnv1a_runtime(names[i].c_str()));
+            std::cout << "  " << hash << "  " << names[i] << "  " << inputs[i].size() << " bytes" << std::endl;
+        }
+        std::cout << "cw_pack: " << output << "  " << inputs.size() << " entr" << (inputs.size() == 1 ? "y" : "ies")
+                  << ", " << packed.size() << " packed" << std::endl;
+        return 0;
+    }
+}
+
+int main(int argc, char** argv) {
+    cloakwork::asset::key128 key{};
+    bool have_key = false;
+    uint32_t chunk = cloakwork::asset::DEFAULT_CHUNK_SIZE;
+    uint64_t nonce = 0;
+    uint16_t cipher = cloakwork::asset::CIPHER_CTR32;
+    std::string header_name;
+    bool archive = false;
+    std::vector<std::string> paths;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (arg == "--passphrase" && has_value) {
+            const std::string text = argv[++i];
+            key = cloakwork::asset::derive_key(text.data(), text.size());
+            have_key = true;
+        } else if (arg == "--key" && has_value) {
+            if (!parse_key(argv[++i], key)) {
+                std::cerr << "cw_pack: --key needs 32 hex digits" << std::endl;
+                return 2;
+            }
+            have_key = true;
+        } else if (arg == "--chunk" && has_value) {
+            chunk = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 0));
+        } else if (arg == "--nonce" && has_value) {
+            nonce = std::strtoull(argv[++i], nullptr, 16);
+        } else if (arg == "--cipher" && has_value) {
+            if (!parse_cipher(argv[++i], cipher)) {
+                std::cerr << "cw_pack: --cipher must be ctr32, arx8, arx12 or arx20" << std::endl;
+                return 2;
+            }
+        } else if (arg == "--header" && has_value) {
+            header_name = argv[++i];
+        } else if (arg == "--archive") {
+            archive = true;
+        } else if (!arg.empty() && arg[0] == '-') {
+            usage(argv[0]);
+            return 2;
+        } else {
+            paths.push_back(arg);
+        }
+    }
+
+    if (!have_key || (archive ? paths.size() < 2 : paths.size() != 2)) {
+        usage(argv[0]);
+        return 2;
+    }
+    if (archive) return pack_archive(paths, key, nonce, cipher, header_name);
+
+    if (chunk == 0 || chunk % 64 != 0) {
+        std::cerr << "cw_pack: --chunk must be a non-zero multiple of 64" << std::endl;
+        return 2;
+    }
+
+    // the input is mapped, not read, so packing a large asset needs one output-sized buffer
+    cloakwork::asset::mapped_file input;
+    if (!input.open(paths[0].c_str())) {
+        std::cerr << "cw_pack: cannot map " << paths[0] << " (missing or empty)" << std::endl;
+        return 1;
+    }
+
+    std::vector<uint8_t> packed = cloakwork::asset::pack(input.data(), input.size(), key, chunk, nonce, cipher);
+    if (packed.empty()) {
+        std::cerr << "cw_pack: " << paths[0] << " is too large for chunk size " << chunk << std::endl;
+        return 1;
+    }
+
+    // round trip before writing anything out
+    cloakwork::asset::encrypted_asset check(packed.data(), packed.size(), key);
+    std::vector<uint8_t> verify_buffer(chunk);
+    bool ok = check.valid();
+    for (size_t c = 0; ok && c < check.chunk_count(); ++c) {
+        ok = static_cast<bool>(check.chunk(c, verify_buffer.data(), true));
+    }
+    if (!ok) {
+        std::cerr << "cw_pack: round-trip verification failed" << std::endl;
+        return 1;
+    }
+
+    if (!write_output(paths[1], header_name, packed)) {
+        std::cerr << "cw_pack: failed to write " << paths[1] << std::endl;
+        return 1;
+    }
+
+    std::cout << "cw_pack: " << paths[0] << " -> " << paths[1] << "  " << input.size() << " bytes, "
+              << check.chunk_count() << " chunk" << (check.chunk_count() == 1 ? "" : "s") << " of " << chunk
+              << ", " << packed.size() << " packed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,227 @@
+#!/usr/bin/env python3
+# cw_size_report - code-size and compile-time cost of each cloakwork primitive
+#
+# generates one synthetic translation unit per primitive with N protected sites
+# (each in its own function, each with a distinct literal or constant so every
+# site gets its own keys), compiles it and records:
+#
+#   compile_s        - best-of-R wall time of the compile
+#   text_bytes       - executable sections of the object file
+#   data_bytes       - allocated non-executable sections (.data, .rodata, .bss, ...)
+#   instantiations   - functions defined by an extra -O0 compile of the same unit. with
+#                      inlining off every template instantiation, member function and
+#                      lambda the sites use is emitted, so this counts what the compiler
+#                      had to instantiate even when -O2 later folds it away
+#
+# plus the growth of each number over a baseline unit with the same N plain sites.
+# with --shared the whole matrix is repeated with CW_SHARE_INSTANTIATIONS=1.
+# with --headers it also times a unit that only includes each modular header, which
+# is what a translation unit pays before its first protected site.
+#
+#   python3 tools/cw_size_report.py --cxx g++ --uses 64 --out size_report.json
+#
+# sizes and symbol counts need elf objects (linux); elsewhere only times are reported.
+
+import argparse
+import json
+import os
+import shlex
+import struct
+import subprocess
+import sys
+import tempfile
+import time
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+
+# per-site snippets; {k} is the site index, {v} a distinct 32-bit constant
+PRIMITIVES = {
+    "baseline":       "cw_sink = {v}u;",
+    "CW_STR":         'cw_sink = static_cast<uint8_t>(CW_STR("protected literal {k:05d}")[0]);',
+    "CW_STR_LAYERED": 'cw_sink = static_cast<uint8_t>(CW_STR_LAYERED("protected literal {k:05d}")[0]);',
+    "CW_STR_ARX":     'cw_sink = static_cast<uint8_t>(CW_STR_ARX("protected literal {k:05d}")[0]);',
+    "CW_WSTR":        'cw_sink = static_cast<uint64_t>(CW_WSTR(L"protected literal {k:05d}")[0]);',
+    "CW_INT":         "cw_sink = static_cast<uint64_t>(static_cast<int>(CW_INT(static_cast<int>(cw_sink) + {k})));",
+    "CW_MBA":         "cw_sink = static_cast<uint64_t>(static_cast<int>(CW_MBA(static_cast<int>(cw_sink) + {k})));",
+    "CW_SCATTER":     "cw_sink = static_cast<uint64_t>(CW_SCATTER(static_cast<uint64_t>(cw_sink) + {k}u));",
+    "CW_POLY":        "cw_sink = static_cast<uint64_t>(CW_POLY(static_cast<uint64_t>(cw_sink) + {k}u));",
+    "CW_CALL":        "cw_sink = static_cast<uint64_t>(CW_CALL(cw_target)(static_cast<int>(cw_sink) + {k}));",
+    "CW_FLATTEN":     "cw_sink = static_cast<uint64_t>(CW_FLATTEN(cw_target, static_cast<int>(cw_sink) + {k}));",
+    "CW_CONST":       "cw_sink = cw_sink + CW_CONST({v}u);",
+}
+
+PRELUDE = """#include "cloakwork.h"
+#include <cstdint>
+
+volatile uint64_t cw_sink;
+int cw_target(int x) { return x * 3 + 1; }
+"""
+
+HEADERS = [
+    "cloakwork.h",
+    "cloakwork/core.h",
+    "cloakwork/keystream.h",
+    "cloakwork/secret_arena.h",
+    "cloakwork/string.h",
+    "cloakwork/hash.h",
+    "cloakwork/value.h",
+    "cloakwork/control_flow.h",
+    "cloakwork/function.h",
+    "cloakwork/data_hiding.h",
+    "cloakwork/metamorphic.h",
+    "cloakwork/anti_debug.h",
+    "cloakwork/imports.h",
+    "cloakwork/integrity.h",
+    "cloakwork/asset.h",
+    "cloakwork/registry.h",
+]
+
+SHF_ALLOC = 0x2
+SHF_EXECINSTR = 0x4
+SHT_SYMTAB = 2
+STT_FUNC = 2
+
+
+def make_unit(snippet, uses):
+    lines = [PRELUDE]
+    for k in range(uses):
+        v = (k * 2654435761 + 0x5EED) & 0xFFFFFFFF
+        lines.append("void cw_site_%d() { %s }" % (k, snippet.format(k=k, v=v)))
+    return "\n".join(lines) + "\n"
+
+
+def elf_stats(path):
+    """section sizes and defined function count of an elf relocatable, or None"""
+    with open(path, "rb") as f:
+        blob = f.read()
+    if blob[:4] != b"\x7fELF":
+        return None
+
+    is64 = blob[4] == 2
+    end = "<" if blob[5] == 1 else ">"
+    if is64:
+        shoff, = struct.unpack_from(end + "Q", blob, 0x28)
+        shentsize, shnum = struct.unpack_from(end + "HH", blob, 0x3A)
+        shfmt, symfmt = end + "IIQQQQIIQQ", end + "IBBHQQ"
+    else:
+        shoff, = struct.unpack_from(end + "I", blob, 0x20)
+        shentsize, shnum = struct.unpack_from(end + "HH", blob, 0x2E)
+        shfmt, symfmt = end + "IIIIIIIIII", end + "IIIBBH"
+
+    text = data = funcs = 0
+    for i in range(shnum):
+        sh = struct.unpack_from(shfmt, blob, shoff + i * shentsize)
+        sh_type, sh_flags, sh_offset, sh_size, sh_entsize = sh[1], sh[2], sh[4], sh[5], sh[9]
+        if sh_flags & SHF_ALLOC:
+            if sh_flags & SHF_EXECINSTR:
+                text += sh_size
+            else:
+                data += sh_size
+        if sh_type == SHT_SYMTAB and sh_entsize:
+            for off in range(sh_offset, sh_offset + sh_size, sh_entsize):
+                sym = struct.unpack_from(symfmt, blob, off)
+                info = sym[1] if is64 else sym[3]
+                shndx = sym[3] if is64 else sym[5]
+                if (info & 0xF) == STT_FUNC and shndx != 0:
+                    funcs += 1
+    return {"text_bytes": text, "data_bytes": data, "functions": funcs}
+
+
+def compile_unit(cmd):
+    start = time.perf_counter()
+    proc = subprocess.run(cmd, stdout=subprocess.PIPE, stderr=subprocess.PIPE, text=True)
+    elapsed = time.perf_counter() - start
+    if proc.returncode != 0:
+        sys.stderr.write(proc.stderr)
+        raise RuntimeError("compile failed: " + " ".join(cmd))
+    return elapsed
+
+
+def measure(cxx, flags, include, snippet, uses, repeat, workdir, tag):
+    src = os.path.join(workdir, tag + ".cpp")
+    obj = os.path.join(workdir, tag + ".o")
+    with open(src, "w") as f:
+        f.write(make_unit(snippet, uses))
+
+    cmd = [cxx] + flags + ["-I", include, "-c", src, "-o", obj]
+    best = min(compile_unit(cmd) for _ in range(max(repeat, 1)))
+
+    result = {"compile_s": round(best, 3)}
+    stats = elf_stats(obj)
+    if stats:
+        result["text_bytes"] = stats["text_bytes"]
+        result["data_bytes"] = stats["data_bytes"]
+
+        # the last -O flag wins, so appending -O0 turns inlining off
+        compile_unit(cmd + ["-O0"])
+        result["instantiations"] = elf_stats(obj)["functions"]
+    return result
+
+
+def header_costs(args, workdir):
+    flags = shlex.split(args.flags)
+    src = os.path.join(workdir, "header.cpp")
+    obj = os.path.join(workdir, "header.o")
+    rows = {}
+    for header in HEADERS:
+        sys.stderr.write("  include %s\n" % header)
+        with open(src, "w") as f:
+            f.write('#include "%s"\n' % header)
+        cmd = [args.cxx] + flags + ["-I", args.include, "-c", src, "-o", obj]
+        rows[header] = round(min(compile_unit(cmd) for _ in range(max(args.repeat, 1))), 3)
+    return rows
+
+
+def run_matrix(args, extra_flags, workdir):
+    flags = shlex.split(args.flags) + extra_flags
+    rows = {}
+    for name, snippet in PRIMITIVES.items():
+        if args.only and name != "baseline" and name not in args.only:
+            continue
+        sys.stderr.write("  %-16s %s\n" % (name, " ".join(extra_flags)))
+        rows[name] = measure(args.cxx, flags, args.include, snippet, args.uses, args.repeat, workdir, name)
+
+    base = rows["baseline"]
+    for name, row in rows.items():
+        if name == "baseline":
+            continue
+        for key in ("compile_s", "text_bytes", "data_bytes", "instantiations"):
+            if key in row and key in base:
+                row[key + "_growth"] = round(row[key] - base[key], 3)
+        if "text_bytes_growth" in row:
+            row["text_bytes_per_use"] = round(row["text_bytes_growth"] / args.uses, 1)
+    return rows
+
+
+def main():
+    parser = argparse.ArgumentParser(description="per-primitive code-size and compile-time report")
+    parser.add_argument("--cxx", default=os.environ.get("CXX", "c++"), help="compiler driver")
+    parser.add_argument("--flags", default="-std=c++20 -O2", help="compile flags")
+    parser.add_argument("--include", default=os.path.dirname(HERE), help="directory containing cloakwork.h")
+    parser.add_argument("--uses", type=int, default=64, help="protected sites per unit")
+    parser.add_argument("--repeat", type=int, default=3, help="compiles per unit (best time wins)")
+    parser.add_argument("--only", nargs="*", help="restrict to these primitives")
+    parser.add_argument("--shared", action="store_true", help="also measure CW_SHARE_INSTANTIATIONS=1")
+    parser.add_argument("--headers", action="store_true", help="also time including each modular header")
+    parser.add_argument("--out", help="json output path (stdout if omitted)")
+    args = parser.parse_args()
+
+    report = {"compiler": args.cxx, "flags": args.flags, "uses": args.uses, "primitives": {}}
+    with tempfile.TemporaryDirectory(prefix="cw_size_") as workdir:
+        report["primitives"] = run_matrix(args, [], workdir)
+        if args.shared:
+            report["shared_instantiations"] = run_matrix(args, ["-DCW_SHARE_INSTANTIATIONS=1"], workdir)
+        if args.headers:
+            report["include_compile_s"] = header_costs(args, workdir)
+
+    text = json.dumps(report, indent=2)
+    if args.out:
+        with open(args.out, "w") as f:
+            f.write(text + "\n")
+    else:
+        print(text)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())